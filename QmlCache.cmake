@@ -0,0 +1,51 @@
+#! Ahead of time compilation for the qml files of the Latte packages.
+#! qmlcachegen creates a .qmlc file for each .qml file and the .qmlc files
+#! are installed next to their sources, Qt loads them instead of compiling
+#! the qml files at runtime. CMake preserves the file timestamps during
+#! installation, so the cached units are accepted by the qml engine.
+
+option(BUILD_QML_CACHE "Precompile the qml files of Latte packages with qmlcachegen" ON)
+
+if(BUILD_QML_CACHE)
+    get_target_property(QT_QMAKE_LOCATION Qt5::qmake IMPORTED_LOCATION)
+    get_filename_component(QT_BINARY_DIR ${QT_QMAKE_LOCATION} DIRECTORY)
+
+    find_program(QMLCACHEGEN_EXECUTABLE NAMES qmlcachegen qmlcachegen-qt5 HINTS ${QT_BINARY_DIR})
+
+    if(NOT QMLCACHEGEN_EXECUTABLE OR Qt5Core_VERSION VERSION_LESS "5.11.0")
+        message(STATUS "qmlcachegen (Qt >= 5.11) was not found, qml files will be compiled at runtime")
+        set(BUILD_QML_CACHE OFF)
+    else()
+        message(STATUS "qmlcachegen : ${QMLCACHEGEN_EXECUTABLE}")
+        add_custom_target(qmlcache ALL)
+    endif()
+endif()
+
+#! latte_install_qml_cache(<target name> <package source dir> <package install dir>)
+function(latte_install_qml_cache name source_dir destination)
+    if(NOT BUILD_QML_CACHE)
+        return()
+    endif()
+
+    file(GLOB_RECURSE qml_files RELATIVE ${source_dir} ${source_dir}/*.qml)
+
+    set(cache_files)
+
+    foreach(qml_file ${qml_files})
+        set(cache_file ${CMAKE_CURRENT_BINARY_DIR}/qmlcache/${name}/${qml_file}c)
+        get_filename_component(cache_dir ${cache_file} DIRECTORY)
+        get_filename_component(qml_dir ${qml_file} DIRECTORY)
+
+        add_custom_command(OUTPUT ${cache_file}
+                           COMMAND ${CMAKE_COMMAND} -E make_directory ${cache_dir}
+                           COMMAND ${QMLCACHEGEN_EXECUTABLE} -o ${cache_file} ${source_dir}/${qml_file}
+                           DEPENDS ${source_dir}/${qml_file}
+                           COMMENT "Precompiling ${name}/${qml_file}")
+
+        install(FILES ${cache_file} DESTINATION ${destination}/${qml_dir})
+        list(APPEND cache_files ${cache_file})
+    endforeach()
+
+    add_custom_target(qmlcache-${name} DEPENDS ${cache_files})
+    add_dependencies(qmlcache qmlcache-${name})
+endfunction()
@@ -0,0 +1,139 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "componentwarmer.h"
+
+// local
+#include "lattecorona.h"
+#include "indicator/factory.h"
+#include "layouts/importer.h"
+
+// Qt
+#include <QDebug>
+#include <QFileInfo>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QUrl>
+
+// KDE
+#include <KConfigGroup>
+#include <KDeclarative/QmlObjectSharedEngine>
+#include <KPackage/Package>
+#include <KPackage/PackageLoader>
+#include <KSharedConfig>
+
+namespace Latte {
+
+ComponentWarmer::ComponentWarmer(Latte::Corona *corona)
+    : QObject(corona),
+      m_corona(corona),
+      m_sharedEngine(new KDeclarative::QmlObjectSharedEngine(this))
+{
+    //! the engine component cache is cleared when indicators are updated
+    connect(m_corona->indicatorFactory(), &Latte::Indicator::Factory::pluginsUpdated, this, &ComponentWarmer::clear);
+}
+
+ComponentWarmer::~ComponentWarmer()
+{
+    clear();
+}
+
+void ComponentWarmer::clear()
+{
+    qDeleteAll(m_components);
+    m_components.clear();
+}
+
+void ComponentWarmer::warmUpForLayout(const QString &layoutName)
+{
+    //! only the qml that is loaded through the applets shared engine is warmed up,
+    //! the view ui is loaded by every view in its own engine and is not included
+    QStringList files;
+
+    for (const auto &pluginId : {QStringLiteral("org.kde.latte.containment"), QStringLiteral("org.kde.latte.plasmoid")}) {
+        KPackage::Package package = KPackage::PackageLoader::self()->loadPackage(QStringLiteral("Plasma/Applet"), pluginId);
+
+        if (package.isValid()) {
+            files << package.filePath("mainscript");
+        }
+    }
+
+    for (const auto &indicator : layoutIndicators(layoutName)) {
+        files << m_corona->indicatorFactory()->uiPath(indicator);
+    }
+
+    for (const auto &file : files) {
+        warmUp(file);
+    }
+}
+
+void ComponentWarmer::warmUp(const QString &file)
+{
+    if (file.isEmpty() || !QFileInfo(file).exists()) {
+        return;
+    }
+
+    const QUrl url = QUrl::fromLocalFile(file);
+
+    for (const auto component : m_components) {
+        if (component->url() == url) {
+            return;
+        }
+    }
+
+    //! asynchronous components are compiled and their imports are
+    //! resolved in the engine loader thread, nothing is instantiated
+    auto component = new QQmlComponent(m_sharedEngine->engine(), url, QQmlComponent::Asynchronous, this);
+
+    connect(component, &QQmlComponent::statusChanged, this, [component](QQmlComponent::Status status) {
+        if (status == QQmlComponent::Ready) {
+            qDebug() << "component warmer :: ready :" << component->url();
+        } else if (status == QQmlComponent::Error) {
+            qDebug() << "component warmer :: failed :" << component->url() << component->errorString();
+        }
+    });
+
+    m_components << component;
+}
+
+QStringList ComponentWarmer::layoutIndicators(const QString &layoutName) const
+{
+    QStringList indicators{QStringLiteral("org.kde.latte.default")};
+
+    const QString layoutFile = Layouts::Importer::layoutFilePath(layoutName);
+
+    if (!QFileInfo(layoutFile).exists()) {
+        return indicators;
+    }
+
+    KSharedConfigPtr layoutConfig = KSharedConfig::openConfig(layoutFile);
+    KConfigGroup containments = KConfigGroup(layoutConfig, "Containments");
+
+    for (const auto &cId : containments.groupList()) {
+        QString type = containments.group(cId).group("Indicator").readEntry("type", QString());
+
+        if (!type.isEmpty() && !indicators.contains(type) && m_corona->indicatorFactory()->pluginExists(type)) {
+            indicators << type;
+        }
+    }
+
+    return indicators;
+}
+
+}
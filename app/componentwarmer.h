@@ -0,0 +1,75 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef COMPONENTWARMER_H
+#define COMPONENTWARMER_H
+
+// Qt
+#include <QList>
+#include <QObject>
+#include <QStringList>
+
+class QQmlComponent;
+
+namespace KDeclarative {
+class QmlObjectSharedEngine;
+}
+
+namespace Latte {
+class Corona;
+}
+
+namespace Latte {
+
+//! ComponentWarmer compiles the main qml files of Latte packages
+//! asynchronously in the qml engine that is shared with all applets.
+//! The compilations run in the engine loader thread while the layout
+//! is being loaded, so the first applets find their components already
+//! compiled in the engine type cache.
+class ComponentWarmer : public QObject
+{
+    Q_OBJECT
+
+public:
+    ComponentWarmer(Latte::Corona *corona);
+    ~ComponentWarmer() override;
+
+    //! warms the containment and tasks plasmoid components and
+    //! the indicators that are used from the views of that layout
+    void warmUpForLayout(const QString &layoutName);
+
+public slots:
+    void clear();
+
+private:
+    void warmUp(const QString &file);
+
+    QStringList layoutIndicators(const QString &layoutName) const;
+
+private:
+    Latte::Corona *m_corona{nullptr};
+    KDeclarative::QmlObjectSharedEngine *m_sharedEngine{nullptr};
+
+    //! components are kept alive in order for their compiled types to stay in the engine cache
+    QList<QQmlComponent *> m_components;
+};
+
+}
+
+#endif
@@ -0,0 +1,592 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "framebenchmark.h"
+
+// local
+#include "lattecorona.h"
+#include "layout/centrallayout.h"
+#include "layouts/importer.h"
+#include "layouts/manager.h"
+#include "layouts/persistence.h"
+#include "settings/universalsettings.h"
+#include "view/positioner.h"
+#include "view/view.h"
+#include "view/visibilitymanager.h"
+#include "wm/windowsindex.h"
+#include "../liblatte2/types.h"
+
+// Qt
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <QMetaMethod>
+#include <QMouseEvent>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+// Plasma
+#include <Plasma/Applet>
+#include <Plasma/Containment>
+
+// C++
+#include <algorithm>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace Latte {
+
+namespace {
+const int FINDVIEWINTERVAL = 1000;
+const int FINDVIEWATTEMPTS = 60;
+//! time given to the view to finish its startup animations
+const int SETTLEINTERVAL = 3000;
+//! time given to the running animations after the last synthetic event
+const int COOLDOWNINTERVAL = 1000;
+
+const int HOVERSTEPINTERVAL = 16;
+const int HOVERSTEPSPERSWEEP = 120;
+const int HOVERSWEEPS = 4;
+
+const int SLIDESTEPINTERVAL = 1000;
+const int SLIDESTEPS = 6;
+
+const int TASKSTEPINTERVAL = 500;
+const int TASKLAUNCHERS = 6;
+
+//! every location change slides the view out and back in
+const int LOCATIONSTEPINTERVAL = 3000;
+const int LOCATIONSTEPS = 4;
+}
+
+FrameBenchmark::FrameBenchmark(Latte::Corona *corona, const QString &outputFile)
+    : QObject(corona),
+      m_outputFile(outputFile),
+      m_corona(corona)
+{
+    m_clock.start();
+
+    m_stepTimer.setSingleShot(true);
+    connect(&m_stepTimer, &QTimer::timeout, this, &FrameBenchmark::step);
+
+    //! with threaded render loops the scenegraph signals are emitted from the
+    //! render thread and the frame measurements would be racing with the gui thread
+    if (qgetenv("QSG_RENDER_LOOP") != "basic") {
+        QTimer::singleShot(0, this, [&]() {
+            refuse(QStringLiteral("the basic render loop is required"));
+        });
+        return;
+    }
+
+    WindowSystem::WindowsIndexMetrics::reset();
+    WindowSystem::WindowsIndexMetrics::setEnabled(true);
+
+    QTimer::singleShot(FINDVIEWINTERVAL, this, &FrameBenchmark::prepareLayout);
+}
+
+FrameBenchmark::~FrameBenchmark()
+{
+    //! the layouts have already been unloaded and synced at this point
+    if (!m_benchmarkLayout.isEmpty()) {
+        QFile::remove(Layouts::Importer::layoutFilePath(m_benchmarkLayout));
+    }
+}
+
+void FrameBenchmark::prepareLayout()
+{
+    if (!m_corona) {
+        return;
+    }
+
+    if (m_corona->layoutsManager()->memoryUsage() != Types::SingleLayout) {
+        refuse(QStringLiteral("the single layout mode is required"));
+        return;
+    }
+
+    CentralLayout *layout = m_corona->layoutsManager()->currentLayout();
+
+    if (!layout) {
+        if (++m_attempts < FINDVIEWATTEMPTS) {
+            QTimer::singleShot(FINDVIEWINTERVAL, this, &FrameBenchmark::prepareLayout);
+        } else {
+            refuse(QStringLiteral("no layout was loaded"));
+        }
+
+        return;
+    }
+
+    //! the running layout must be up to date in its file before it is copied
+    m_corona->layoutsManager()->persistence()->flush();
+
+    QString benchmarkLayout = Layouts::Importer::uniqueLayoutName(QStringLiteral("Benchmark"));
+
+    if (!QFile::copy(Layouts::Importer::layoutFilePath(layout->name()), Layouts::Importer::layoutFilePath(benchmarkLayout))) {
+        refuse(QStringLiteral("the current layout could not be copied"));
+        return;
+    }
+
+    m_benchmarkLayout = benchmarkLayout;
+    m_originalLayout = layout->name();
+    m_originalLastNonAssignedLayout = m_corona->universalSettings()->lastNonAssignedLayoutName();
+
+    qDebug() << "frame benchmark :: running on layout" << m_benchmarkLayout << "copied from" << m_originalLayout;
+
+    m_attempts = 0;
+    m_corona->layoutsManager()->switchToLayout(m_benchmarkLayout);
+
+    QTimer::singleShot(FINDVIEWINTERVAL, this, &FrameBenchmark::findView);
+}
+
+void FrameBenchmark::refuse(const QString &reason)
+{
+    qWarning() << "frame benchmark :: refused to run," << reason;
+
+    m_scenario = Finished;
+    m_stepTimer.stop();
+
+    QCoreApplication::exit(1);
+}
+
+void FrameBenchmark::findView()
+{
+    CentralLayout *layout = m_corona ? m_corona->layoutsManager()->currentLayout() : nullptr;
+
+    if (layout && layout->name() == m_benchmarkLayout) {
+        for (const auto view : layout->latteViews()) {
+            if (view->isVisible()) {
+                m_view = view;
+                break;
+            }
+        }
+    }
+
+    if (!m_view) {
+        if (++m_attempts < FINDVIEWATTEMPTS) {
+            QTimer::singleShot(FINDVIEWINTERVAL, this, &FrameBenchmark::findView);
+        } else {
+            qWarning() << "frame benchmark :: no view was found...";
+            finish();
+        }
+
+        return;
+    }
+
+    qDebug() << "frame benchmark :: measuring view" << m_view->containment()->id();
+
+    //! the basic render loop emits all scenegraph signals from the gui thread
+    connect(m_view, &QQuickWindow::beforeSynchronizing, this, &FrameBenchmark::beforeSynchronizing);
+    connect(m_view, &QQuickWindow::afterSynchronizing, this, &FrameBenchmark::afterSynchronizing);
+    connect(m_view, &QQuickWindow::beforeRendering, this, &FrameBenchmark::beforeRendering);
+    connect(m_view, &QQuickWindow::afterRendering, this, &FrameBenchmark::afterRendering);
+    connect(m_view, &QQuickWindow::frameSwapped, this, &FrameBenchmark::frameSwapped);
+
+    QTimer::singleShot(SETTLEINTERVAL, this, [&]() {
+        startScenario(HoverSweep);
+    });
+}
+
+QString FrameBenchmark::scenarioName(Scenario scenario) const
+{
+    switch (scenario) {
+    case HoverSweep:
+        return QStringLiteral("hover-sweep");
+
+    case SlideOutIn:
+        return QStringLiteral("slide-out-in");
+
+    case AddRemoveTasks:
+        return QStringLiteral("add-remove-tasks");
+
+    case LocationChange:
+        return QStringLiteral("location-change");
+
+    default:
+        return QString();
+    }
+}
+
+void FrameBenchmark::startScenario(Scenario scenario)
+{
+    if (!m_view) {
+        finish();
+        return;
+    }
+
+    m_scenario = scenario;
+    m_step = 0;
+    m_lastSwap = -1;
+    m_frame = Frame();
+    m_frames.clear();
+
+    qDebug() << "frame benchmark :: scenario started" << scenarioName(scenario);
+
+    m_stepTimer.start(0);
+}
+
+void FrameBenchmark::step()
+{
+    if (!m_view) {
+        finish();
+        return;
+    }
+
+    if (m_scenario == HoverSweep) {
+        const int steps = HOVERSWEEPS * HOVERSTEPSPERSWEEP;
+
+        if (m_step < steps) {
+            int sweepStep = m_step % HOVERSTEPSPERSWEEP;
+            bool forward = ((m_step / HOVERSTEPSPERSWEEP) % 2 == 0);
+            qreal progress = (qreal)sweepStep / (HOVERSTEPSPERSWEEP - 1);
+
+            hoverAt(forward ? progress : 1 - progress);
+            m_step++;
+            m_stepTimer.start(HOVERSTEPINTERVAL);
+        } else {
+            leave();
+            QTimer::singleShot(COOLDOWNINTERVAL, this, &FrameBenchmark::finishScenario);
+        }
+    } else if (m_scenario == SlideOutIn) {
+        if (m_step < SLIDESTEPS) {
+            m_view->visibility()->setIsHidden(m_step % 2 == 0);
+            m_step++;
+            m_stepTimer.start(SLIDESTEPINTERVAL);
+        } else {
+            m_view->visibility()->setIsHidden(false);
+            QTimer::singleShot(COOLDOWNINTERVAL, this, &FrameBenchmark::finishScenario);
+        }
+    } else if (m_scenario == AddRemoveTasks) {
+        if (m_step == 0) {
+            m_launchers = benchmarkLaunchers();
+        }
+
+        //! all launchers are added one by one and afterwards they are removed in the same order
+        if (m_step < 2 * m_launchers.count()) {
+            bool adding = (m_step < m_launchers.count());
+            QString launcher = m_launchers[m_step % m_launchers.count()];
+
+            if (!invokeOnTasks(adding ? "extSignalAddLauncher(QVariant,QVariant)" : "extSignalRemoveLauncher(QVariant,QVariant)", launcher)) {
+                qWarning() << "frame benchmark :: no latte tasks were found in view...";
+                QTimer::singleShot(COOLDOWNINTERVAL, this, &FrameBenchmark::finishScenario);
+                return;
+            }
+
+            m_step++;
+            m_stepTimer.start(TASKSTEPINTERVAL);
+        } else {
+            QTimer::singleShot(COOLDOWNINTERVAL, this, &FrameBenchmark::finishScenario);
+        }
+    } else if (m_scenario == LocationChange) {
+        if (m_step < LOCATIONSTEPS) {
+            //! the view moves to the opposite edge and back, the same way the settings window moves it
+            Plasma::Types::Location location = m_view->location();
+            Plasma::Types::Location opposite;
+
+            switch (location) {
+            case Plasma::Types::TopEdge:
+                opposite = Plasma::Types::BottomEdge;
+                break;
+
+            case Plasma::Types::LeftEdge:
+                opposite = Plasma::Types::RightEdge;
+                break;
+
+            case Plasma::Types::RightEdge:
+                opposite = Plasma::Types::LeftEdge;
+                break;
+
+            default:
+                opposite = Plasma::Types::TopEdge;
+                break;
+            }
+
+            m_view->positioner()->hideDockDuringLocationChange(opposite);
+            m_step++;
+            m_stepTimer.start(LOCATIONSTEPINTERVAL);
+        } else {
+            QTimer::singleShot(COOLDOWNINTERVAL, this, &FrameBenchmark::finishScenario);
+        }
+    }
+}
+
+QStringList FrameBenchmark::benchmarkLaunchers() const
+{
+    QStringList launchers;
+
+    for (const auto &path : QStandardPaths::standardLocations(QStandardPaths::ApplicationsLocation)) {
+        QDir applications(path);
+
+        for (const auto &file : applications.entryList(QStringList() << QStringLiteral("*.desktop"), QDir::Files, QDir::Name)) {
+            QString launcher = QStringLiteral("applications:") + file;
+
+            if (!launchers.contains(launcher)) {
+                launchers << launcher;
+            }
+
+            if (launchers.count() == TASKLAUNCHERS) {
+                return launchers;
+            }
+        }
+    }
+
+    return launchers;
+}
+
+bool FrameBenchmark::invokeOnTasks(const char *signature, const QString &launcher)
+{
+    bool invoked{false};
+
+    for (const auto applet : m_view->containment()->applets()) {
+        if (applet->kPackage().metadata().pluginId() != QLatin1String("org.kde.latte.plasmoid")) {
+            continue;
+        }
+
+        QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>();
+
+        if (!appletInterface) {
+            continue;
+        }
+
+        for (QQuickItem *item : appletInterface->childItems()) {
+            int methodIndex = item->metaObject()->indexOfMethod(signature);
+
+            if (methodIndex == -1) {
+                continue;
+            }
+
+            //! the tasks plasmoid accepts only changes for the launchers group of its view
+            QObject *latteView = item->property("latteView").value<QObject *>();
+            QVariant group = latteView ? latteView->property("launchersGroup") : QVariant();
+
+            QMetaMethod method = item->metaObject()->method(methodIndex);
+
+            if (method.invoke(item, Q_ARG(QVariant, group), Q_ARG(QVariant, launcher))) {
+                invoked = true;
+            }
+        }
+    }
+
+    return invoked;
+}
+
+void FrameBenchmark::hoverAt(qreal progress)
+{
+    QPointF pos;
+    //! the items are placed at the screen edge side of the view
+    qreal thickness = qMax(1, m_view->normalThickness()) / 2.0;
+
+    switch (m_view->location()) {
+    case Plasma::Types::TopEdge:
+        pos = QPointF(progress * (m_view->width() - 1), thickness);
+        break;
+
+    case Plasma::Types::LeftEdge:
+        pos = QPointF(thickness, progress * (m_view->height() - 1));
+        break;
+
+    case Plasma::Types::RightEdge:
+        pos = QPointF(m_view->width() - thickness, progress * (m_view->height() - 1));
+        break;
+
+    default:
+        pos = QPointF(progress * (m_view->width() - 1), m_view->height() - thickness);
+        break;
+    }
+
+    QElapsedTimer input;
+    input.start();
+
+    QMouseEvent move(QEvent::MouseMove, pos, m_view->mapToGlobal(pos.toPoint()), Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+    QCoreApplication::sendEvent(m_view, &move);
+
+    //! bindings and js handlers that are triggered from hovering are evaluated synchronously
+    m_frame.input += input.nsecsElapsed();
+}
+
+void FrameBenchmark::leave()
+{
+    QEvent leaveEvent(QEvent::Leave);
+    QCoreApplication::sendEvent(m_view, &leaveEvent);
+}
+
+void FrameBenchmark::beforeSynchronizing()
+{
+    m_syncStart = m_clock.nsecsElapsed();
+}
+
+void FrameBenchmark::afterSynchronizing()
+{
+    m_frame.sync += m_clock.nsecsElapsed() - m_syncStart;
+}
+
+void FrameBenchmark::beforeRendering()
+{
+    m_renderStart = m_clock.nsecsElapsed();
+}
+
+void FrameBenchmark::afterRendering()
+{
+    m_frame.render += m_clock.nsecsElapsed() - m_renderStart;
+}
+
+void FrameBenchmark::frameSwapped()
+{
+    if (m_scenario == Idle || m_scenario == Finished) {
+        return;
+    }
+
+    qint64 now = m_clock.nsecsElapsed();
+    qint64 heap = heapInUse();
+
+    if (m_lastSwap >= 0) {
+        m_frame.interval = now - m_lastSwap;
+        m_frame.heap = heap - m_lastHeap;
+        m_frames << m_frame;
+    }
+
+    m_frame = Frame();
+    m_lastSwap = now;
+    m_lastHeap = heap;
+}
+
+QJsonObject FrameBenchmark::statistics(const QVector<qint64> &values) const
+{
+    QJsonObject result;
+
+    if (values.isEmpty()) {
+        return result;
+    }
+
+    QVector<qint64> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+
+    qint64 sum{0};
+
+    for (const auto value : sorted) {
+        sum += value;
+    }
+
+    auto percentile = [&sorted](int p) {
+        return sorted[qMin(sorted.count() - 1, (sorted.count() * p) / 100)];
+    };
+
+    //! times are reported in microseconds
+    result["avg"] = (double)sum / sorted.count() / 1000;
+    result["p50"] = (double)percentile(50) / 1000;
+    result["p95"] = (double)percentile(95) / 1000;
+    result["max"] = (double)sorted.last() / 1000;
+
+    return result;
+}
+
+void FrameBenchmark::finishScenario()
+{
+    QVector<qint64> intervals;
+    QVector<qint64> syncs;
+    QVector<qint64> renders;
+    QVector<qint64> inputs;
+    qint64 heap{0};
+
+    for (const auto &frame : m_frames) {
+        intervals << frame.interval;
+        syncs << frame.sync;
+        renders << frame.render;
+        inputs << frame.input;
+        heap += frame.heap;
+    }
+
+    QJsonObject result;
+    result["scenario"] = scenarioName(m_scenario);
+    result["frames"] = m_frames.count();
+    result["frameIntervalUs"] = statistics(intervals);
+    result["syncUs"] = statistics(syncs);
+    result["renderUs"] = statistics(renders);
+    result["inputUs"] = statistics(inputs);
+    result["heapBytesPerFrame"] = m_frames.isEmpty() ? 0 : (double)heap / m_frames.count();
+
+    m_results << result;
+
+    qDebug() << "frame benchmark :: scenario finished" << scenarioName(m_scenario) << "with" << m_frames.count() << "frames";
+
+    if (m_scenario == HoverSweep) {
+        startScenario(SlideOutIn);
+    } else if (m_scenario == SlideOutIn) {
+        startScenario(AddRemoveTasks);
+    } else if (m_scenario == AddRemoveTasks) {
+        startScenario(LocationChange);
+    } else {
+        finish();
+    }
+}
+
+void FrameBenchmark::finish()
+{
+    m_scenario = Finished;
+    m_stepTimer.stop();
+
+    QJsonObject root;
+    root["platform"] = QGuiApplication::platformName();
+    root["sceneGraphBackend"] = QQuickWindow::sceneGraphBackend();
+    root["results"] = m_results;
+
+    const quint64 lookups = WindowSystem::WindowsIndexMetrics::lookups();
+    QJsonObject windowsIndex;
+    windowsIndex["lookups"] = (double)lookups;
+    windowsIndex["averageLookupNs"] = lookups == 0 ? 0 : (double)WindowSystem::WindowsIndexMetrics::lookupsNsecs() / lookups;
+    root["windowsIndex"] = windowsIndex;
+
+    QSaveFile file(m_outputFile);
+
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(root).toJson());
+        file.commit();
+        qDebug() << "frame benchmark :: results written to" << m_outputFile;
+    } else {
+        qWarning() << "frame benchmark :: results could not be written to" << m_outputFile;
+    }
+
+    //! the temporary layout must not be loaded on the next startup
+    if (!m_originalLayout.isEmpty() && m_corona) {
+        m_corona->universalSettings()->setCurrentLayoutName(m_originalLayout);
+        m_corona->universalSettings()->setLastNonAssignedLayoutName(m_originalLastNonAssignedLayout);
+    }
+
+    QCoreApplication::quit();
+}
+
+qint64 FrameBenchmark::heapInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return (qint64)info.uordblks + (qint64)info.hblkhd;
+#elif defined(__GLIBC__)
+    struct mallinfo info = mallinfo();
+    return (qint64)info.uordblks + (qint64)info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+}
@@ -0,0 +1,140 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FRAMEBENCHMARK_H
+#define FRAMEBENCHMARK_H
+
+// Qt
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+namespace Latte {
+class Corona;
+class View;
+}
+
+namespace Latte {
+
+//! FrameBenchmark drives synthetic interaction scenarios on the first
+//! loaded view and measures every rendered frame. It is enabled with the
+//! --benchmark-frames command line option and together with the offscreen
+//! qpa and the software scenegraph it can be used to catch qml performance
+//! regressions without a gpu or a compositor, e.g.:
+//! QT_QPA_PLATFORM=offscreen QT_QUICK_BACKEND=software latte-dock --single --benchmark-frames results.json
+//! The scenarios run on a temporary copy of the current layout, so tasks and
+//! location changes never reach the user layouts. Frames are measured only with
+//! the basic render loop that renders in the gui thread.
+//! When all scenarios are finished the results are written and Latte exits.
+class FrameBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    FrameBenchmark(Latte::Corona *corona, const QString &outputFile);
+    ~FrameBenchmark() override;
+
+private slots:
+    void prepareLayout();
+    void findView();
+    void step();
+
+    void beforeSynchronizing();
+    void afterSynchronizing();
+    void beforeRendering();
+    void afterRendering();
+    void frameSwapped();
+
+private:
+    enum Scenario {
+        Idle = 0,
+        HoverSweep,
+        SlideOutIn,
+        AddRemoveTasks,
+        LocationChange,
+        Finished
+    };
+
+    struct Frame {
+        qint64 interval{0};
+        qint64 sync{0};
+        qint64 render{0};
+        qint64 input{0};
+        qint64 heap{0};
+    };
+
+    void startScenario(Scenario scenario);
+    void finishScenario();
+    void finish();
+
+    void refuse(const QString &reason);
+
+    void hoverAt(qreal progress);
+    void leave();
+
+    bool invokeOnTasks(const char *signature, const QString &launcher);
+
+    QStringList benchmarkLaunchers() const;
+
+    QString scenarioName(Scenario scenario) const;
+    QJsonObject statistics(const QVector<qint64> &values) const;
+
+    static qint64 heapInUse();
+
+private:
+    int m_step{0};
+    int m_attempts{0};
+
+    qint64 m_lastSwap{-1};
+    qint64 m_syncStart{0};
+    qint64 m_renderStart{0};
+    qint64 m_lastHeap{0};
+
+    QString m_outputFile;
+
+    //! the temporary layout that the scenarios run on and the layout it was copied from
+    QString m_benchmarkLayout;
+    QString m_originalLayout;
+    QString m_originalLastNonAssignedLayout;
+
+    QStringList m_launchers;
+
+    Scenario m_scenario{Idle};
+
+    //! measurements of the frame that is currently being rendered
+    Frame m_frame;
+    QVector<Frame> m_frames;
+
+    QJsonArray m_results;
+
+    QElapsedTimer m_clock;
+    QTimer m_stepTimer;
+
+    QPointer<Latte::Corona> m_corona;
+    QPointer<Latte::View> m_view;
+};
+
+}
+
+#endif
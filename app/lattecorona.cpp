@@ -22,8 +22,11 @@
 
 // local
 #include "alternativeshelper.h"
+#include "componentwarmer.h"
 #include "lattedockadaptor.h"
 #include "screenpool.h"
+#include "startuptracer.h"
+#include "statusservice.h"
 #include "indicator/factory.h"
 #include "layout/centrallayout.h"
 #include "layout/genericlayout.h"
@@ -38,10 +41,12 @@
 #include "plasma/extended/theme.h"
 #include "settings/universalsettings.h"
 #include "view/view.h"
+#include "view/viewpool.h"
 #include "view/windowstracker/windowstracker.h"
 #include "view/windowstracker/allscreenstracker.h"
 #include "view/windowstracker/currentscreentracker.h"
 #include "wm/abstractwindowinterface.h"
+#include "wm/appdatacache.h"
 #include "wm/schemecolors.h"
 #include "wm/waylandinterface.h"
 #include "wm/xwindowinterface.h"
@@ -91,12 +96,14 @@ Corona::Corona(bool defaultLayoutOnStartup, QString layoutNameOnStartUp, int use
       m_layoutNameOnStartUp(layoutNameOnStartUp),
       m_activityConsumer(new KActivities::Consumer(this)),
       m_screenPool(new ScreenPool(KSharedConfig::openConfig(), this)),
-      m_indicatorFactory(new Indicator::Factory(this)),
       m_universalSettings(new UniversalSettings(KSharedConfig::openConfig(), this)),
       m_globalShortcuts(new GlobalShortcuts(this)),
+      m_indicatorFactory(new Indicator::Factory(this)),
+      m_layoutsManager(new Layouts::Manager(this)),
+      m_viewPool(new ViewPool(this)),
+      m_componentWarmer(new ComponentWarmer(this)),
       m_plasmaScreenPool(new PlasmaExtended::ScreenPool(this)),
-      m_themeExtended(new PlasmaExtended::Theme(KSharedConfig::openConfig(), this)),
-      m_layoutsManager(new Layouts::Manager(this))
+      m_themeExtended(new PlasmaExtended::Theme(KSharedConfig::openConfig(), this))
 {
     //! create the window manager
 
@@ -126,8 +133,20 @@ Corona::Corona(bool defaultLayoutOnStartup, QString layoutNameOnStartUp, int use
     m_universalSettings->load();
     m_themeExtended->load();
 
+    m_wm->setWindowChangesInterval(m_universalSettings->windowChangesInterval());
+    connect(m_universalSettings, &UniversalSettings::windowChangesIntervalChanged, this, [this]() {
+        m_wm->setWindowChangesInterval(m_universalSettings->windowChangesInterval());
+    });
+
+    m_wm->appDataCache()->setPersistent(m_universalSettings->persistentAppDataCache());
+    connect(m_universalSettings, &UniversalSettings::persistentAppDataCacheChanged, this, [this]() {
+        m_wm->appDataCache()->setPersistent(m_universalSettings->persistentAppDataCache());
+    });
+
     qmlRegisterTypes();
 
+    StartupTracer::begin(QStringLiteral("corona: waiting activities"));
+
     if (m_activityConsumer && (m_activityConsumer->serviceStatus() == KActivities::Consumer::Running)) {
         load();
     }
@@ -142,15 +161,20 @@ Corona::Corona(bool defaultLayoutOnStartup, QString layoutNameOnStartUp, int use
     });
 
     //! initialize the background tracer for broadcasted backgrounds
+    StartupTracer::begin(QStringLiteral("corona: background tracer"));
     m_backgroundTracer = new KDeclarative::QmlObjectSharedEngine(this);
     m_backgroundTracer->setInitializationDelayed(true);
     m_backgroundTracer->setSource(kPackage().filePath("backgroundTracer"));
     m_backgroundTracer->completeInitialization();
+    StartupTracer::end(QStringLiteral("corona: background tracer"));
 
     //! Dbus adaptor initialization
     new LatteDockAdaptor(this);
     QDBusConnection dbus = QDBusConnection::sessionBus();
     dbus.registerObject(QStringLiteral("/Latte"), this);
+
+    //! typed status and metrics service at /Latte/Status
+    new StatusService(this);
 }
 
 Corona::~Corona()
@@ -181,6 +205,8 @@ Corona::~Corona()
 
     qDebug() << "Latte Corona - unload: containments ...";
 
+    //! views must not be kept for reuse when closing
+    m_viewPool->setCapacity(0);
     m_layoutsManager->unload();
 
     m_wm->deleteLater();
@@ -204,6 +230,9 @@ void Corona::load()
     if (m_activityConsumer && (m_activityConsumer->serviceStatus() == KActivities::Consumer::Running) && m_activitiesStarting) {
         m_activitiesStarting = false;
 
+        StartupTracer::end(QStringLiteral("corona: waiting activities"));
+        StartupTracer::Span span(QStringLiteral("corona: load"));
+
         disconnect(m_activityConsumer, &KActivities::Consumer::serviceStatusChanged, this, &Corona::load);
 
         m_layoutsManager->load();
@@ -247,6 +276,9 @@ void Corona::load()
             m_universalSettings->setLayoutsMemoryUsage(Types::SingleLayout);
         }
 
+        //! compile the main qml components in parallel while the layout is loading
+        m_componentWarmer->warmUpForLayout(loadLayoutName);
+
         m_layoutsManager->loadLayoutOnStartup(loadLayoutName);
 
 
@@ -428,6 +460,11 @@ Indicator::Factory *Corona::indicatorFactory() const
     return m_indicatorFactory;
 }
 
+ViewPool *Corona::viewPool() const
+{
+    return m_viewPool;
+}
+
 Layouts::Manager *Corona::layoutsManager() const
 {
     return m_layoutsManager;
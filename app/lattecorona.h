@@ -64,7 +64,9 @@ namespace Latte {
 class ScreenPool;
 class GlobalShortcuts;
 class UniversalSettings;
+class ComponentWarmer;
 class View;
+class ViewPool;
 namespace Indicator{
 class Factory;
 }
@@ -127,6 +129,7 @@ public:
     Layouts::Manager *layoutsManager() const;   
 
     Indicator::Factory *indicatorFactory() const;
+    ViewPool *viewPool() const;
 
     PlasmaExtended::ScreenPool *plasmaScreenPool() const;
     PlasmaExtended::Theme *themeExtended() const;
@@ -209,6 +212,8 @@ private:
 
     Indicator::Factory *m_indicatorFactory{nullptr};
     Layouts::Manager *m_layoutsManager{nullptr};
+    ViewPool *m_viewPool{nullptr};
+    ComponentWarmer *m_componentWarmer{nullptr};
 
     PlasmaExtended::ScreenPool *m_plasmaScreenPool{nullptr};
     PlasmaExtended::Theme *m_themeExtended{nullptr};
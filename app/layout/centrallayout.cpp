@@ -323,13 +323,8 @@ int CentralLayout::viewsCount(int screen) const
     int views = Layout::GenericLayout::viewsCount(screen);
 
     if (m_sharedLayout) {
-        QScreen *scr = m_corona->screenPool()->screenForId(screen);
-
-        for (const auto view : m_sharedLayout->latteViews()) {
-            if (view && view->screen() == scr && !view->containment()->destroyed()) {
-                ++views;
-            }
-        }
+        //! the shared layout views are counted from its own views index
+        views += m_sharedLayout->Layout::GenericLayout::viewsCount(screen);
     }
 
     return views;
@@ -344,11 +339,7 @@ int CentralLayout::viewsCount(QScreen *screen) const
     int views = Layout::GenericLayout::viewsCount(screen);
 
     if (m_sharedLayout) {
-        for (const auto view : m_sharedLayout->latteViews()) {
-            if (view && view->screen() == screen && !view->containment()->destroyed()) {
-                ++views;
-            }
-        }
+        views += m_sharedLayout->Layout::GenericLayout::viewsCount(screen);
     }
 
     return views;
@@ -363,11 +354,7 @@ int CentralLayout::viewsCount() const
     int views = Layout::GenericLayout::viewsCount();
 
     if (m_sharedLayout) {
-        for (const auto view : m_sharedLayout->latteViews()) {
-            if (view && view->containment() && !view->containment()->destroyed()) {
-                ++views;
-            }
-        }
+        views += m_sharedLayout->Layout::GenericLayout::viewsCount();
     }
 
     return views;
@@ -386,11 +373,11 @@ QList<Plasma::Types::Location> CentralLayout::availableEdgesForView(QScreen *scr
     edges = Layout::GenericLayout::availableEdgesForView(scr, forView);
 
     if (m_sharedLayout) {
-        for (const auto view : m_sharedLayout->latteViews()) {
-            //! make sure that availabe edges takes into account only views that should be excluded,
-            //! this is why the forView should not be excluded
-            if (view && view != forView && view->positioner()->currentScreenName() == scr->name()) {
-                edges.removeOne(view->location());
+        const auto sharedEdges = m_sharedLayout->Layout::GenericLayout::availableEdgesForView(scr, forView);
+
+        for (int i = edges.count() - 1; i >= 0; --i) {
+            if (!sharedEdges.contains(edges[i])) {
+                edges.removeAt(i);
             }
         }
     }
@@ -411,9 +398,11 @@ QList<Plasma::Types::Location> CentralLayout::freeEdges(QScreen *scr) const
     edges = Layout::GenericLayout::freeEdges(scr);
 
     if (m_sharedLayout) {
-        for (const auto view : m_sharedLayout->latteViews()) {
-            if (view && view->positioner()->currentScreenName() == scr->name()) {
-                edges.removeOne(view->location());
+        const auto sharedEdges = m_sharedLayout->Layout::GenericLayout::freeEdges(scr);
+
+        for (int i = edges.count() - 1; i >= 0; --i) {
+            if (!sharedEdges.contains(edges[i])) {
+                edges.removeAt(i);
             }
         }
     }
@@ -432,12 +421,13 @@ QList<Plasma::Types::Location> CentralLayout::freeEdges(int screen) const
     }
 
     edges = Layout::GenericLayout::freeEdges(screen);
-    QScreen *scr = m_corona->screenPool()->screenForId(screen);
 
     if (m_sharedLayout) {
-        for (const auto view : m_sharedLayout->latteViews()) {
-            if (view && scr && view->positioner()->currentScreenName() == scr->name()) {
-                edges.removeOne(view->location());
+        const auto sharedEdges = m_sharedLayout->Layout::GenericLayout::freeEdges(screen);
+
+        for (int i = edges.count() - 1; i >= 0; --i) {
+            if (!sharedEdges.contains(edges[i])) {
+                edges.removeAt(i);
             }
         }
     }
@@ -462,9 +452,12 @@ Types::ViewType CentralLayout::latteViewType(int containmentId) const
 
 QList<Latte::View *> CentralLayout::sortedLatteViews(QList<Latte::View *> views)
 {
-    QList<Latte::View *> vws = latteViews();
+    if (m_sharedLayout) {
+        //! views from both layouts are sorted together
+        return Layout::GenericLayout::sortedLatteViews(latteViews());
+    }
 
-    return Layout::GenericLayout::sortedLatteViews(vws);
+    return Layout::GenericLayout::sortedLatteViews();
 }
 
 QList<Latte::View *> CentralLayout::viewsWithPlasmaShortcuts()
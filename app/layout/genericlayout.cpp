@@ -28,8 +28,10 @@
 #include "../layouts/manager.h"
 #include "../layouts/synchronizer.h"
 #include "../shortcuts/shortcutstracker.h"
+#include "../startuptracer.h"
 #include "../view/view.h"
 #include "../view/positioner.h"
+#include "../view/viewpool.h"
 
 // Qt
 #include <QDebug>
@@ -97,6 +99,8 @@ void GenericLayout::unloadContainments()
         m_containments.removeFirst();
         delete containment;
     }
+
+    invalidateViewsIndex();
 }
 
 void GenericLayout::unloadLatteViews()
@@ -123,10 +127,18 @@ void GenericLayout::unloadLatteViews()
         view->disconnectSensitiveSignals();
     }
 
-    qDeleteAll(m_latteViews);
+    //! views that are kept from the view pool are reused by the next loaded layout
+    for (const auto view : m_latteViews) {
+        if (!m_corona->viewPool()->release(view)) {
+            delete view;
+        }
+    }
+
     qDeleteAll(m_waitingLatteViews);
     m_latteViews.clear();
     m_waitingLatteViews.clear();
+
+    invalidateViewsIndex();
 }
 
 bool GenericLayout::blockAutomaticLatteViewCreation() const
@@ -186,15 +198,8 @@ int GenericLayout::viewsCount(int screen) const
 
     QScreen *scr = m_corona->screenPool()->screenForId(screen);
 
-    int views{0};
-
-    for (const auto view : m_latteViews) {
-        if (view && view->screen() == scr && !view->containment()->destroyed()) {
-            ++views;
-        }
-    }
-
-    return views;
+    updateViewsIndex();
+    return m_viewsIndex.viewsCount(scr);
 }
 
 int GenericLayout::viewsCount(QScreen *screen) const
@@ -203,15 +208,8 @@ int GenericLayout::viewsCount(QScreen *screen) const
         return 0;
     }
 
-    int views{0};
-
-    for (const auto view : m_latteViews) {
-        if (view && view->screen() == screen && !view->containment()->destroyed()) {
-            ++views;
-        }
-    }
-
-    return views;
+    updateViewsIndex();
+    return m_viewsIndex.viewsCount(screen);
 }
 
 int GenericLayout::viewsCount() const
@@ -220,15 +218,8 @@ int GenericLayout::viewsCount() const
         return 0;
     }
 
-    int views{0};
-
-    for (const auto view : m_latteViews) {
-        if (view && view->containment() && !view->containment()->destroyed()) {
-            ++views;
-        }
-    }
-
-    return views;
+    updateViewsIndex();
+    return m_viewsIndex.viewsCount();
 }
 
 QList<int> GenericLayout::qmlFreeEdges(int screen) const
@@ -254,17 +245,12 @@ QList<Plasma::Types::Location> GenericLayout::freeEdges(QScreen *scr) const
     QList<Types::Location> edges{Types::BottomEdge, Types::LeftEdge,
                 Types::TopEdge, Types::RightEdge};
 
-    if (!m_corona) {
+    if (!m_corona || !scr) {
         return edges;
     }
 
-    for (const auto view : m_latteViews) {
-        if (view && view->positioner()->currentScreenName() == scr->name()) {
-            edges.removeOne(view->location());
-        }
-    }
-
-    return edges;
+    updateViewsIndex();
+    return m_viewsIndex.freeEdges(scr->name());
 }
 
 QList<Plasma::Types::Location> GenericLayout::freeEdges(int screen) const
@@ -279,13 +265,12 @@ QList<Plasma::Types::Location> GenericLayout::freeEdges(int screen) const
 
     QScreen *scr = m_corona->screenPool()->screenForId(screen);
 
-    for (const auto view : m_latteViews) {
-        if (view && scr && view->positioner()->currentScreenName() == scr->name()) {
-            edges.removeOne(view->location());
-        }
+    if (!scr) {
+        return edges;
     }
 
-    return edges;
+    updateViewsIndex();
+    return m_viewsIndex.freeEdges(scr->name());
 }
 
 int GenericLayout::viewsWithTasks() const
@@ -369,118 +354,68 @@ QList<Latte::View *> GenericLayout::latteViews()
 
 QList<Latte::View *> GenericLayout::sortedLatteViews(QList<Latte::View *> views)
 {
-    QList<Latte::View *> sortedViews = views.isEmpty() ? latteViews() : views;
+    if (!views.isEmpty()) {
+        return ViewsIndex::sortViews(views);
+    }
 
-    qDebug() << " -------- ";
+    updateViewsIndex();
+    return m_viewsIndex.sortedViews();
+}
 
-    for (int i = 0; i < sortedViews.count(); ++i) {
-        qDebug() << i << ". " << sortedViews[i]->screen()->name() << " - " << sortedViews[i]->location();
-    }
+void GenericLayout::invalidateViewsIndex()
+{
+    m_viewsIndex.invalidate();
+}
 
-    //! sort the views based on screens and edges priorities
-    //! views on primary screen have higher priority and
-    //! for views in the same screen the priority goes to
-    //! Bottom,Left,Top,Right
-    for (int i = 0; i < sortedViews.size(); ++i) {
-        for (int j = 0; j < sortedViews.size() - i - 1; ++j) {
-            if (viewAtLowerScreenPriority(sortedViews[j], sortedViews[j + 1])
-                    || (sortedViews[j]->screen() == sortedViews[j + 1]->screen()
-                        && viewAtLowerEdgePriority(sortedViews[j], sortedViews[j + 1]))) {
-                Latte::View *temp = sortedViews[j + 1];
-                sortedViews[j + 1] = sortedViews[j];
-                sortedViews[j] = temp;
-            }
-        }
+void GenericLayout::updateViewsIndex() const
+{
+    if (m_viewsIndex.isValid()) {
+        return;
     }
 
-    Latte::View *highestPriorityView{nullptr};
+    QList<Latte::View *> views;
 
-    for (int i = 0; i < sortedViews.size(); ++i) {
-        if (sortedViews[i]->isPreferredForShortcuts()) {
-            highestPriorityView = sortedViews[i];
-            sortedViews.removeAt(i);
-            break;
+    for (const auto view : m_latteViews) {
+        if (!view) {
+            continue;
         }
-    }
 
-    if (highestPriorityView) {
-        sortedViews.prepend(highestPriorityView);
+        views << view;
     }
 
-    qDebug() << " -------- sorted -----";
+    QList<Plasma::Containment *> containments;
 
-    for (int i = 0; i < sortedViews.count(); ++i) {
-        qDebug() << i << ". " << sortedViews[i]->isPreferredForShortcuts() << " - " << sortedViews[i]->screen()->name() << " - " << sortedViews[i]->location();
+    for (const auto containment : m_containments) {
+        if (m_storage && m_storage->isLatteContainment(containment)) {
+            containments << containment;
+        }
     }
 
-    return sortedViews;
+    m_viewsIndex.rebuild(views, containments);
 }
 
-bool GenericLayout::viewAtLowerScreenPriority(Latte::View *test, Latte::View *base)
+//! views moving to other screens or edges invalidate the index
+void GenericLayout::connectViewToViewsIndex(Latte::View *view)
 {
-    if (!base || ! test) {
-        return true;
-    }
-
-    if (base->screen() == test->screen()) {
-        return false;
-    } else if (base->screen() != qGuiApp->primaryScreen() && test->screen() == qGuiApp->primaryScreen()) {
-        return false;
-    } else if (base->screen() == qGuiApp->primaryScreen() && test->screen() != qGuiApp->primaryScreen()) {
-        return true;
-    } else {
-        int basePriority = -1;
-        int testPriority = -1;
-
-        for (int i = 0; i < qGuiApp->screens().count(); ++i) {
-            if (base->screen() == qGuiApp->screens()[i]) {
-                basePriority = i;
-            }
-
-            if (test->screen() == qGuiApp->screens()[i]) {
-                testPriority = i;
-            }
-        }
-
-        if (testPriority <= basePriority) {
-            return true;
-        } else {
-            return false;
-        }
-
+    if (!view) {
+        return;
     }
 
-    qDebug() << "viewAtLowerScreenPriority : shouldn't had reached here...";
-    return false;
+    connect(view, &QWindow::screenChanged, this, &GenericLayout::invalidateViewsIndex, Qt::UniqueConnection);
+    connect(view, &Latte::View::locationChanged, this, &GenericLayout::invalidateViewsIndex, Qt::UniqueConnection);
+    connect(view, &Latte::View::onPrimaryChanged, this, &GenericLayout::invalidateViewsIndex, Qt::UniqueConnection);
+    connect(view, &Latte::View::isPreferredForShortcutsChanged, this, &GenericLayout::invalidateViewsIndex, Qt::UniqueConnection);
+    connect(view->positioner(), &ViewPart::Positioner::currentScreenChanged, this, &GenericLayout::invalidateViewsIndex, Qt::UniqueConnection);
 }
 
-bool GenericLayout::viewAtLowerEdgePriority(Latte::View *test, Latte::View *base)
+void GenericLayout::connectContainmentToViewsIndex(Plasma::Containment *containment)
 {
-    if (!base || ! test) {
-        return true;
-    }
-
-    QList<Plasma::Types::Location> edges{Plasma::Types::RightEdge, Plasma::Types::TopEdge,
-                Plasma::Types::LeftEdge, Plasma::Types::BottomEdge};
-
-    int testPriority = -1;
-    int basePriority = -1;
-
-    for (int i = 0; i < edges.count(); ++i) {
-        if (edges[i] == base->location()) {
-            basePriority = i;
-        }
-
-        if (edges[i] == test->location()) {
-            testPriority = i;
-        }
+    if (!containment || !m_storage || !m_storage->isLatteContainment(containment)) {
+        return;
     }
 
-    if (testPriority < basePriority) {
-        return true;
-    } else {
-        return false;
-    }
+    connect(containment, &Plasma::Containment::locationChanged, this, &GenericLayout::invalidateViewsIndex, Qt::UniqueConnection);
+    connect(containment, &Plasma::Containment::screenChanged, this, &GenericLayout::invalidateViewsIndex, Qt::UniqueConnection);
 }
 
 bool GenericLayout::viewDataAtLowerScreenPriority(const ViewData &test, const ViewData &base) const
@@ -619,6 +554,12 @@ void GenericLayout::addContainment(Plasma::Containment *containment)
     }
 
     if (containmentInLayout) {
+        connectContainmentToViewsIndex(containment);
+
+        if (m_storage && m_storage->isLatteContainment(containment)) {
+            m_viewsIndex.addContainment(containment);
+        }
+
         if (!blockAutomaticLatteViewCreation()) {
             addView(containment);
         } else {
@@ -663,6 +604,7 @@ void GenericLayout::containmentDestroyed(QObject *cont)
 
         if (containmentIndex >= 0) {
             m_containments.removeAt(containmentIndex);
+            invalidateViewsIndex();
         }
 
         qDebug() << "Layout " << name() << " :: containment destroyed!!!!";
@@ -673,6 +615,7 @@ void GenericLayout::containmentDestroyed(QObject *cont)
         }
 
         if (view) {
+            m_viewsIndex.removeView(view);
             view->disconnectSensitiveSignals();
 
             view->deleteLater();
@@ -698,8 +641,10 @@ void GenericLayout::destroyedChanged(bool destroyed)
 
     if (destroyed) {
         m_waitingLatteViews[sender] = m_latteViews.take(static_cast<Plasma::Containment *>(sender));
+        m_viewsIndex.removeView(m_waitingLatteViews[sender]);
     } else {
         m_latteViews[sender] = m_waitingLatteViews.take(static_cast<Plasma::Containment *>(sender));
+        m_viewsIndex.addView(m_latteViews[sender]);
     }
 
     emit viewEdgeChanged();
@@ -829,8 +774,11 @@ void GenericLayout::addView(Plasma::Containment *containment, bool forceOnPrimar
             if (!testOnPrimary && m_corona->screenPool()->primaryScreenId() == testScreenId && testLocation == containment->location()) {
                 qDebug() << "Rejected explicit latteView and removing it in order add an onPrimary with higher priority at screen: " << connector;
                 auto viewToDelete = m_latteViews.take(testContainment);
-                viewToDelete->disconnectSensitiveSignals();
-                viewToDelete->deleteLater();
+                m_viewsIndex.removeView(viewToDelete);
+
+                if (!m_corona->viewPool()->release(viewToDelete)) {
+                    viewToDelete->deleteLater();
+                }
             }
         }
     }
@@ -849,9 +797,12 @@ void GenericLayout::addView(Plasma::Containment *containment, bool forceOnPrimar
         byPassWM = containment->config().readEntry("byPassWM", false);
     }
 
-    auto latteView = new Latte::View(m_corona, nextScreen, byPassWM);
+    StartupTracer::Span span(QStringLiteral("layout: add view"));
 
-    latteView->init();
+    //! recreated views must be rebuilt with their new window flags,
+    //! so they never reuse a pooled window
+    auto latteView = m_viewsToRecreate.contains(containment) ? m_corona->viewPool()->create(nextScreen, byPassWM)
+                                                             : m_corona->viewPool()->acquire(nextScreen, byPassWM);
     latteView->setContainment(containment);
 
     //! force this special dock case to become primary
@@ -871,6 +822,8 @@ void GenericLayout::addView(Plasma::Containment *containment, bool forceOnPrimar
     //}
 
     m_latteViews[containment] = latteView;
+    connectViewToViewsIndex(latteView);
+    m_viewsIndex.addView(latteView);
 
     emit viewsCountChanged();
 }
@@ -906,6 +859,11 @@ bool GenericLayout::initToCorona(Latte::Corona *corona)
 
     connect(m_corona, &Plasma::Corona::containmentAdded, this, &GenericLayout::addContainment);
 
+    //! screens priorities are part of the views index
+    connect(qGuiApp, &QGuiApplication::screenAdded, this, &GenericLayout::invalidateViewsIndex);
+    connect(qGuiApp, &QGuiApplication::screenRemoved, this, &GenericLayout::invalidateViewsIndex);
+    connect(qGuiApp, &QGuiApplication::primaryScreenChanged, this, &GenericLayout::invalidateViewsIndex);
+
     //!connect signals after adding the containment
     connect(this, &GenericLayout::viewsCountChanged, m_corona, &Plasma::Corona::availableScreenRectChanged);
     connect(this, &GenericLayout::viewsCountChanged, m_corona, &Plasma::Corona::availableScreenRegionChanged);
@@ -948,6 +906,14 @@ void GenericLayout::assignToLayout(Latte::View *latteView, QList<Plasma::Contain
         m_latteViews[latteView->containment()] = latteView;
         m_containments << containments;
 
+        connectViewToViewsIndex(latteView);
+
+        for (const auto containment : containments) {
+            connectContainmentToViewsIndex(containment);
+        }
+
+        invalidateViewsIndex();
+
         for (const auto containment : containments) {
             containment->config().writeEntry("layoutId", name());
 
@@ -967,7 +933,7 @@ void GenericLayout::assignToLayout(Latte::View *latteView, QList<Plasma::Contain
 
     //! sync the original layout file for integrity
     if (m_corona && m_corona->layoutsManager()->memoryUsage() == Types::MultipleLayouts) {
-        m_storage->syncToLayoutFile(false);
+        m_corona->layoutsManager()->persistence()->markDirty(this);
     }
 }
 
@@ -1003,9 +969,11 @@ QList<Plasma::Containment *> GenericLayout::unassignFromLayout(Latte::View *latt
         m_latteViews.remove(latteView->containment());
     }
 
+    invalidateViewsIndex();
+
     //! sync the original layout file for integrity
     if (m_corona && m_corona->layoutsManager()->memoryUsage() == Types::MultipleLayouts) {
-        m_storage->syncToLayoutFile(false);
+        m_corona->layoutsManager()->persistence()->markDirty(this);
     }
 
     return containments;
@@ -1024,11 +992,8 @@ void GenericLayout::recreateView(Plasma::Containment *containment, bool delayed)
     //! step:1 remove the latteview
     QTimer::singleShot(delay, [this, containment]() {
         auto view = m_latteViews[containment];
-        view->disconnectSensitiveSignals();
 
-        //! step:2 add the new latteview
-        connect(view, &QObject::destroyed, this, [this, containment]() {
-            auto view = m_latteViews.take(containment);
+        auto addNewView = [this, containment]() {
             QTimer::singleShot(250, this, [this, containment]() {
                 if (!m_latteViews.contains(containment)) {
                     qDebug() << "recreate - step 2: adding dock for containment:" << containment->id();
@@ -1036,6 +1001,16 @@ void GenericLayout::recreateView(Plasma::Containment *containment, bool delayed)
                     m_viewsToRecreate.removeAll(containment);
                 }
             });
+        };
+
+        //! step:2 add the new latteview, the old one is not released to the
+        //! view pool because a recreated window must not be reused
+        view->disconnectSensitiveSignals();
+
+        connect(view, &QObject::destroyed, this, [this, view, containment, addNewView]() {
+            m_latteViews.remove(containment);
+            m_viewsIndex.removeView(view);
+            addNewView();
         });
 
         view->deleteLater();
@@ -1062,15 +1037,14 @@ QList<Plasma::Types::Location> GenericLayout::availableEdgesForView(QScreen *scr
         return edges;
     }
 
-    for (const auto view : m_latteViews) {
-        //! make sure that availabe edges takes into account only views that should be excluded,
-        //! this is why the forView should not be excluded
-        if (view && view != forView && view->positioner()->currentScreenName() == scr->name()) {
-            edges.removeOne(view->location());
-        }
+    if (!scr) {
+        return edges;
     }
 
-    return edges;
+    //! make sure that availabe edges takes into account only views that should be excluded,
+    //! this is why the forView should not be excluded
+    updateViewsIndex();
+    return m_viewsIndex.availableEdgesForView(scr->name(), forView);
 }
 
 bool GenericLayout::explicitDockOccupyEdge(int screen, Plasma::Types::Location location) const
@@ -1079,19 +1053,8 @@ bool GenericLayout::explicitDockOccupyEdge(int screen, Plasma::Types::Location l
         return false;
     }
 
-    for (const auto containment : m_containments) {
-        if (m_storage->isLatteContainment(containment)) {
-            bool onPrimary = containment->config().readEntry("onPrimary", true);
-            int id = containment->lastScreen();
-            Plasma::Types::Location contLocation = containment->location();
-
-            if (!onPrimary && id == screen && contLocation == location) {
-                return true;
-            }
-        }
-    }
-
-    return false;
+    updateViewsIndex();
+    return m_viewsIndex.explicitDockOccupyEdge(screen, location);
 }
 
 bool GenericLayout::primaryDockOccupyEdge(Plasma::Types::Location location) const
@@ -1100,18 +1063,8 @@ bool GenericLayout::primaryDockOccupyEdge(Plasma::Types::Location location) cons
         return false;
     }
 
-    for (const auto containment : m_containments) {
-        if (m_storage->isLatteContainment(containment)) {
-            bool onPrimary = containment->config().readEntry("onPrimary", true);
-            Plasma::Types::Location contLocation = containment->location();
-
-            if (onPrimary && contLocation == location) {
-                return true;
-            }
-        }
-    }
-
-    return false;
+    updateViewsIndex();
+    return m_viewsIndex.primaryDockOccupyEdge(location);
 }
 
 bool GenericLayout::mapContainsId(const Layout::ViewsMap *map, uint viewId) const
@@ -1268,9 +1221,12 @@ void GenericLayout::syncLatteViewsToScreens(Layout::ViewsMap *occupiedMap)
     while(!viewsToDelete.isEmpty()) {
         auto containment = viewsToDelete.takeFirst();
         auto view = m_latteViews.take(containment);
+        m_viewsIndex.removeView(view);
         qDebug() << "syncLatteViewsToScreens: view must be deleted... for containment:" << containment->id() << " at screen:" << view->positioner()->currentScreenName();
-        view->disconnectSensitiveSignals();
-        view->deleteLater();
+
+        if (!m_corona->viewPool()->release(view)) {
+            view->deleteLater();
+        }
     }
 
     //! reconsider views
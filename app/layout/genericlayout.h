@@ -22,6 +22,7 @@
 
 // local
 #include "abstractlayout.h"
+#include "viewsindex.h"
 #include "../../liblatte2/types.h"
 
 // Qt
@@ -178,6 +179,8 @@ private slots:
     void destroyedChanged(bool destroyed);
     void containmentDestroyed(QObject *cont);
 
+    void invalidateViewsIndex();
+
 private:
     //! It can be used in order for LatteViews to not be created automatically when
     //! their corresponding containments are created e.g. copyView functionality
@@ -187,8 +190,10 @@ private:
     bool explicitDockOccupyEdge(int screen, Plasma::Types::Location location) const;
     bool primaryDockOccupyEdge(Plasma::Types::Location location) const;
 
-    bool viewAtLowerScreenPriority(Latte::View *test, Latte::View *base);
-    bool viewAtLowerEdgePriority(Latte::View *test, Latte::View *base);
+    //! rebuilds the views index when it has been invalidated
+    void updateViewsIndex() const;
+    void connectViewToViewsIndex(Latte::View *view);
+    void connectContainmentToViewsIndex(Plasma::Containment *containment);
 
     bool viewDataAtLowerEdgePriority(const ViewData &test, const ViewData &base) const;
     bool viewDataAtLowerScreenPriority(const ViewData &test, const ViewData &base) const;
@@ -209,6 +214,10 @@ private:
 
     QPointer<Storage> m_storage;
 
+    //! screens, edges and priorities of the views, it is rebuilt lazily
+    //! from the const query functions
+    mutable ViewsIndex m_viewsIndex;
+
     //! try to avoid crashes from recreating the same views all the time
     QList<const Plasma::Containment *> m_viewsToRecreate;
 
@@ -157,7 +157,6 @@ void Storage::syncToLayoutFile(bool removeLayoutId)
 
     KConfigGroup oldContainments = KConfigGroup(filePtr, "Containments");
     oldContainments.deleteGroup();
-    oldContainments.sync();
 
     qDebug() << " LAYOUT :: " << m_layout->name() << " is syncing its original file.";
 
@@ -171,10 +170,11 @@ void Storage::syncToLayoutFile(bool removeLayoutId)
 
         if (!removeLayoutId) {
             newGroup.writeEntry("layoutId", "");
-            newGroup.sync();
         }
     }
 
+    //! the file is written only once and atomically, the previous
+    //! containments are never dropped on disk before the new ones are written
     oldContainments.sync();
 }
 
@@ -310,7 +310,7 @@ void Storage::copyView(Plasma::Containment *containment)
         config.writeEntry("lastScreen", dockScrId);
     }
 
-    newContainment->config().sync();
+    m_layout->corona()->layoutsManager()->persistence()->markDirty(newContainment->config());
 
     if (setOnExplicitScreen && copyScrId > -1) {
         qDebug() << "Copy Dock in explicit screen ::: " << copyScrId;
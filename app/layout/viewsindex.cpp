@@ -0,0 +1,312 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "viewsindex.h"
+
+// local
+#include "../view/view.h"
+#include "../view/positioner.h"
+
+// Qt
+#include <QGuiApplication>
+#include <QScreen>
+
+// Plasma
+#include <Plasma/Containment>
+
+// C++
+#include <algorithm>
+
+namespace Latte {
+namespace Layout {
+
+namespace {
+//! the order that free edges are reported
+const std::array<Plasma::Types::Location, 4> EDGES{{Plasma::Types::BottomEdge, Plasma::Types::LeftEdge,
+                                                   Plasma::Types::TopEdge, Plasma::Types::RightEdge}};
+
+//! for views in the same screen the priority goes to Bottom,Left,Top,Right
+int edgePriority(Plasma::Types::Location location)
+{
+    switch (location) {
+    case Plasma::Types::BottomEdge:
+        return 3;
+    case Plasma::Types::LeftEdge:
+        return 2;
+    case Plasma::Types::TopEdge:
+        return 1;
+    case Plasma::Types::RightEdge:
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+//! views on primary screen have higher priority, the rest
+//! of the screens follow their reverse order in the screens list
+int screenPriority(const QScreen *screen, const QList<QScreen *> &screens)
+{
+    if (screen == qGuiApp->primaryScreen()) {
+        return screens.count();
+    }
+
+    return screens.indexOf(const_cast<QScreen *>(screen));
+}
+}
+
+ViewsIndex::ViewsIndex()
+{
+}
+
+bool ViewsIndex::isValid() const
+{
+    return m_valid;
+}
+
+void ViewsIndex::invalidate()
+{
+    m_valid = false;
+}
+
+int ViewsIndex::edgeIndex(Plasma::Types::Location location)
+{
+    for (int i = 0; i < (int)EDGES.size(); ++i) {
+        if (EDGES[i] == location) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+ViewsIndex::EdgesMask ViewsIndex::edgeBit(Plasma::Types::Location location)
+{
+    int index = edgeIndex(location);
+    return (index >= 0 ? (1u << index) : 0);
+}
+
+QList<Plasma::Types::Location> ViewsIndex::edgesFromMask(EdgesMask occupied)
+{
+    QList<Plasma::Types::Location> edges;
+
+    for (int i = 0; i < (int)EDGES.size(); ++i) {
+        if (!(occupied & (1u << i))) {
+            edges << EDGES[i];
+        }
+    }
+
+    return edges;
+}
+
+void ViewsIndex::rebuild(const QList<Latte::View *> &views, const QList<Plasma::Containment *> &containments)
+{
+    m_viewsCount = 0;
+    m_viewsPerScreen.clear();
+    m_occupiedEdges.clear();
+    m_edgeViews.clear();
+    m_placements.clear();
+    m_explicitEdges.clear();
+    m_primaryEdges = 0;
+    m_sortedViews.clear();
+
+    for (const auto view : views) {
+        insertView(view);
+    }
+
+    for (const auto containment : containments) {
+        insertContainment(containment);
+    }
+
+    m_sortedViews = sortViews(m_sortedViews);
+
+    m_valid = true;
+}
+
+void ViewsIndex::addView(Latte::View *view)
+{
+    if (!m_valid || !view || m_placements.contains(view)) {
+        return;
+    }
+
+    insertView(view);
+
+    m_sortedViews = sortViews(m_sortedViews);
+}
+
+void ViewsIndex::removeView(const Latte::View *view)
+{
+    if (!m_valid || !m_placements.contains(view)) {
+        return;
+    }
+
+    const Placement placement = m_placements.take(view);
+
+    if (placement.counted) {
+        --m_viewsCount;
+
+        if (--m_viewsPerScreen[placement.screen] <= 0) {
+            m_viewsPerScreen.remove(placement.screen);
+        }
+    }
+
+    int index = edgeIndex(placement.location);
+
+    if (index >= 0 && m_edgeViews.contains(placement.screenName)) {
+        EdgesCounter &counter = m_edgeViews[placement.screenName];
+
+        if (--counter[index] <= 0) {
+            counter[index] = 0;
+            m_occupiedEdges[placement.screenName] &= ~(1u << index);
+        }
+    }
+
+    m_sortedViews.removeAll(const_cast<Latte::View *>(view));
+}
+
+void ViewsIndex::addContainment(Plasma::Containment *containment)
+{
+    if (!m_valid || !containment) {
+        return;
+    }
+
+    insertContainment(containment);
+}
+
+void ViewsIndex::insertView(Latte::View *view)
+{
+    if (!view) {
+        return;
+    }
+
+    m_sortedViews << view;
+
+    Placement placement;
+    placement.screenName = view->positioner()->currentScreenName();
+    placement.location = view->location();
+    placement.screen = view->screen();
+    placement.counted = (view->containment() && !view->containment()->destroyed());
+
+    if (placement.counted) {
+        ++m_viewsCount;
+        ++m_viewsPerScreen[placement.screen];
+    }
+
+    int index = edgeIndex(placement.location);
+
+    if (index >= 0) {
+        m_occupiedEdges[placement.screenName] |= (1u << index);
+
+        if (!m_edgeViews.contains(placement.screenName)) {
+            m_edgeViews[placement.screenName] = EdgesCounter{{0, 0, 0, 0}};
+        }
+
+        ++m_edgeViews[placement.screenName][index];
+    }
+
+    m_placements[view] = placement;
+}
+
+void ViewsIndex::insertContainment(Plasma::Containment *containment)
+{
+    bool onPrimary = containment->config().readEntry("onPrimary", true);
+    EdgesMask edge = edgeBit(containment->location());
+
+    if (onPrimary) {
+        m_primaryEdges |= edge;
+    } else {
+        m_explicitEdges[containment->lastScreen()] |= edge;
+    }
+}
+
+int ViewsIndex::viewsCount() const
+{
+    return m_viewsCount;
+}
+
+int ViewsIndex::viewsCount(const QScreen *screen) const
+{
+    return m_viewsPerScreen.value(screen, 0);
+}
+
+QList<Plasma::Types::Location> ViewsIndex::freeEdges(const QString &screenName) const
+{
+    return edgesFromMask(m_occupiedEdges.value(screenName, 0));
+}
+
+QList<Plasma::Types::Location> ViewsIndex::availableEdgesForView(const QString &screenName, const Latte::View *forView) const
+{
+    EdgesMask occupied = m_occupiedEdges.value(screenName, 0);
+
+    //! the forView must not be excluded, so its edge is released
+    //! when no other view occupies it
+    if (forView && m_placements.contains(forView) && m_placements[forView].screenName == screenName) {
+        int index = edgeIndex(m_placements[forView].location);
+
+        if (index >= 0 && m_edgeViews[screenName][index] == 1) {
+            occupied &= ~(1u << index);
+        }
+    }
+
+    return edgesFromMask(occupied);
+}
+
+bool ViewsIndex::explicitDockOccupyEdge(int screen, Plasma::Types::Location location) const
+{
+    return (m_explicitEdges.value(screen, 0) & edgeBit(location));
+}
+
+bool ViewsIndex::primaryDockOccupyEdge(Plasma::Types::Location location) const
+{
+    return (m_primaryEdges & edgeBit(location));
+}
+
+QList<Latte::View *> ViewsIndex::sortedViews() const
+{
+    return m_sortedViews;
+}
+
+QList<Latte::View *> ViewsIndex::sortViews(QList<Latte::View *> views)
+{
+    const QList<QScreen *> screens = qGuiApp->screens();
+
+    //! stable sort in order to preserve the previous order of
+    //! views with the same priority
+    std::stable_sort(views.begin(), views.end(), [&screens](const Latte::View *a, const Latte::View *b) {
+        int aScreen = screenPriority(a->screen(), screens);
+        int bScreen = screenPriority(b->screen(), screens);
+
+        if (aScreen != bScreen) {
+            return aScreen > bScreen;
+        }
+
+        return edgePriority(a->location()) > edgePriority(b->location());
+    });
+
+    for (int i = 0; i < views.size(); ++i) {
+        if (views[i]->isPreferredForShortcuts()) {
+            views.move(i, 0);
+            break;
+        }
+    }
+
+    return views;
+}
+
+}
+}
@@ -0,0 +1,135 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LAYOUTVIEWSINDEX_H
+#define LAYOUTVIEWSINDEX_H
+
+// C++
+#include <array>
+
+// Qt
+#include <QHash>
+#include <QList>
+#include <QString>
+
+// Plasma
+#include <Plasma>
+
+class QScreen;
+
+namespace Plasma {
+class Containment;
+}
+
+namespace Latte {
+class View;
+}
+
+namespace Latte {
+namespace Layout {
+
+//! ViewsIndex keeps the screen and edge placement of the views of a layout
+//! together with their priority order. Views that are added or removed are
+//! updated in place, when views are moved or layouts are loaded, unloaded
+//! and switched the index is invalidated and it is rebuilt only once on the
+//! next query. This way all the screen and edge queries of a layout are
+//! answered from the index instead of iterating and sorting all views every time.
+class ViewsIndex
+{
+public:
+    //! edges are stored as bits of an occupancy bitmap
+    using EdgesMask = uint;
+
+    ViewsIndex();
+
+    bool isValid() const;
+    void invalidate();
+
+    //! views must be the views of the layout and containments all the
+    //! latte containments of the layout, including the ones without a view
+    void rebuild(const QList<Latte::View *> &views, const QList<Plasma::Containment *> &containments);
+
+    //! in place updates, they are ignored when the index is not valid
+    //! because the next rebuild is going to include them anyway
+    void addView(Latte::View *view);
+    //! the view is not accessed because it might be already under destruction
+    void removeView(const Latte::View *view);
+    void addContainment(Plasma::Containment *containment);
+
+    int viewsCount() const;
+    int viewsCount(const QScreen *screen) const;
+
+    //! free edges at that screen ordered as Bottom, Left, Top, Right
+    QList<Plasma::Types::Location> freeEdges(const QString &screenName) const;
+    //! free edges at that screen when the forView is not taken into account
+    QList<Plasma::Types::Location> availableEdgesForView(const QString &screenName, const Latte::View *forView) const;
+
+    bool explicitDockOccupyEdge(int screen, Plasma::Types::Location location) const;
+    bool primaryDockOccupyEdge(Plasma::Types::Location location) const;
+
+    //! views sorted based on screens and edges priorities, the preferred
+    //! view for shortcuts is always first
+    QList<Latte::View *> sortedViews() const;
+
+    static EdgesMask edgeBit(Plasma::Types::Location location);
+    static QList<Plasma::Types::Location> edgesFromMask(EdgesMask occupied);
+
+    //! sorts views based on screens and edges priorities, used also for
+    //! views that are not part of an index e.g. shared layouts
+    static QList<Latte::View *> sortViews(QList<Latte::View *> views);
+
+private:
+    //! Bottom, Left, Top, Right
+    using EdgesCounter = std::array<int, 4>;
+
+    struct Placement {
+        QString screenName;
+        Plasma::Types::Location location{Plasma::Types::Floating};
+        const QScreen *screen{nullptr};
+        bool counted{false};
+    };
+
+    static int edgeIndex(Plasma::Types::Location location);
+
+    void insertView(Latte::View *view);
+    void insertContainment(Plasma::Containment *containment);
+
+private:
+    bool m_valid{false};
+
+    int m_viewsCount{0};
+    QHash<const QScreen *, int> m_viewsPerScreen;
+
+    //! SCREEN_NAME -> occupied edges
+    QHash<QString, EdgesMask> m_occupiedEdges;
+    QHash<QString, EdgesCounter> m_edgeViews;
+    //! VIEW -> placement of the view when it was indexed
+    QHash<const Latte::View *, Placement> m_placements;
+
+    //! SCREEN_ID -> edges occupied by explicit docks based on containments
+    QHash<int, EdgesMask> m_explicitEdges;
+    EdgesMask m_primaryEdges{0};
+
+    QList<Latte::View *> m_sortedViews;
+};
+
+}
+}
+
+#endif
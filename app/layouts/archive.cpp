@@ -0,0 +1,304 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "archive.h"
+
+// Qt
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QSaveFile>
+#include <QTemporaryFile>
+
+// KDE
+#include <KArchive/KArchiveDirectory>
+#include <KArchive/KArchiveEntry>
+#include <KArchive/KArchiveFile>
+#include <KConfig>
+#include <KConfigGroup>
+
+namespace Latte {
+namespace Layouts {
+
+namespace {
+const qint64 CHUNKSIZE = 64 * 1024;
+
+//! KArchive closes the devices it writes to, but closing a QSaveFile
+//! is fatal. The archive writer commits or cancels it on its own.
+class ArchiveSaveFile : public QSaveFile
+{
+public:
+    ArchiveSaveFile(const QString &name)
+        : QSaveFile(name)
+    {
+    }
+
+private:
+    void close() override
+    {
+    }
+};
+
+bool copyEntry(const KArchiveFile *entry, QIODevice *destination)
+{
+    QScopedPointer<QIODevice> device(entry->createDevice());
+
+    if (!device || !device->open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    while (!device->atEnd()) {
+        const QByteArray chunk = device->read(CHUNKSIZE);
+
+        if (chunk.isEmpty() || destination->write(chunk) != chunk.size()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool streamEntry(const KArchiveFile *entry, const QString &destinationFile)
+{
+    QSaveFile destination(destinationFile);
+
+    if (!destination.open(QIODevice::WriteOnly)) {
+        qDebug() << "archive entry could not be extracted to :: " << destinationFile;
+        return false;
+    }
+
+    if (!copyEntry(entry, &destination)) {
+        destination.cancelWriting();
+        return false;
+    }
+
+    return destination.commit();
+}
+}
+
+ArchiveReader::ArchiveReader(const QString &file)
+    : m_archive(file, QStringLiteral("application/x-tar"))
+{
+    m_archive.open(QIODevice::ReadOnly);
+}
+
+ArchiveReader::~ArchiveReader()
+{
+    if (m_archive.isOpen()) {
+        m_archive.close();
+    }
+}
+
+bool ArchiveReader::isOpen() const
+{
+    return m_archive.isOpen() && m_archive.directory();
+}
+
+const KArchiveFile *ArchiveReader::file(const QString &path) const
+{
+    if (!isOpen()) {
+        return nullptr;
+    }
+
+    const KArchiveEntry *entry = m_archive.directory()->entry(path);
+
+    if (entry && entry->isFile()) {
+        return static_cast<const KArchiveFile *>(entry);
+    }
+
+    return nullptr;
+}
+
+const KArchiveDirectory *ArchiveReader::directory(const QString &path) const
+{
+    if (!isOpen()) {
+        return nullptr;
+    }
+
+    const KArchiveEntry *entry = m_archive.directory()->entry(path);
+
+    if (entry && entry->isDirectory()) {
+        return static_cast<const KArchiveDirectory *>(entry);
+    }
+
+    return nullptr;
+}
+
+bool ArchiveReader::hasFile(const QString &path) const
+{
+    return file(path) != nullptr;
+}
+
+bool ArchiveReader::hasDirectory(const QString &path) const
+{
+    return directory(path) != nullptr;
+}
+
+QStringList ArchiveReader::rootEntries() const
+{
+    if (!isOpen()) {
+        return QStringList();
+    }
+
+    return m_archive.directory()->entries();
+}
+
+QMap<QString, QString> ArchiveReader::readConfigGroup(const QString &path, const QString &group) const
+{
+    const KArchiveFile *rcFile = file(path);
+
+    if (!rcFile) {
+        return QMap<QString, QString>();
+    }
+
+    //! KConfig reads only from files, a temporary copy of the entry lets it
+    //! unescape the values exactly as they were written
+    QTemporaryFile rcCopy;
+
+    if (!rcCopy.open() || !copyEntry(rcFile, &rcCopy)) {
+        return QMap<QString, QString>();
+    }
+
+    rcCopy.close();
+
+    KConfig rcConfig(rcCopy.fileName(), KConfig::SimpleConfig);
+
+    return KConfigGroup(&rcConfig, group).entryMap();
+}
+
+QString ArchiveReader::readConfigEntry(const QString &path, const QString &group, const QString &key, const QString &defaultValue) const
+{
+    return readConfigGroup(path, group).value(key, defaultValue);
+}
+
+bool ArchiveReader::extractFile(const QString &path, const QString &destinationFile) const
+{
+    const KArchiveFile *entry = file(path);
+
+    if (!entry) {
+        return false;
+    }
+
+    QDir().mkpath(QFileInfo(destinationFile).absolutePath());
+
+    return streamEntry(entry, destinationFile);
+}
+
+bool ArchiveReader::extractDirectory(const QString &path, const QString &destinationPath) const
+{
+    return extractDirectory(directory(path), destinationPath);
+}
+
+bool ArchiveReader::extractDirectory(const KArchiveDirectory *dir, const QString &destinationPath) const
+{
+    if (!dir) {
+        return false;
+    }
+
+    if (!QDir().mkpath(destinationPath)) {
+        return false;
+    }
+
+    for (const auto &name : dir->entries()) {
+        const KArchiveEntry *entry = dir->entry(name);
+        const QString destination = destinationPath + "/" + name;
+
+        if (entry->isDirectory()) {
+            if (!extractDirectory(static_cast<const KArchiveDirectory *>(entry), destination)) {
+                return false;
+            }
+        } else if (entry->isFile()) {
+            if (!streamEntry(static_cast<const KArchiveFile *>(entry), destination)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+ArchiveWriter::ArchiveWriter(const QString &file)
+    : m_saveFile(new ArchiveSaveFile(file)),
+      m_archive(m_saveFile.data())
+{
+    //! the archive is written through a QSaveFile, an existing archive is
+    //! replaced only when close() commits a completely written one
+    m_archive.open(QIODevice::WriteOnly);
+}
+
+ArchiveWriter::~ArchiveWriter()
+{
+    //! an archive that was not closed explicitly is never committed
+    if (m_archive.isOpen()) {
+        m_archive.close();
+    }
+
+    if (m_saveFile->isOpen()) {
+        m_saveFile->cancelWriting();
+    }
+}
+
+bool ArchiveWriter::isOpen() const
+{
+    return m_archive.isOpen();
+}
+
+bool ArchiveWriter::addFile(const QString &localFile, const QString &archivePath)
+{
+    if (!isOpen() || !QFileInfo(localFile).exists()) {
+        m_failed = true;
+        return false;
+    }
+
+    //! addLocalFile streams the file in chunks instead of loading it in memory
+    if (!m_archive.addLocalFile(localFile, archivePath)) {
+        m_failed = true;
+        return false;
+    }
+
+    return true;
+}
+
+bool ArchiveWriter::addData(const QString &archivePath, const QByteArray &data)
+{
+    if (!isOpen() || !m_archive.writeFile(archivePath, data)) {
+        m_failed = true;
+        return false;
+    }
+
+    return true;
+}
+
+bool ArchiveWriter::close()
+{
+    if (!isOpen()) {
+        return false;
+    }
+
+    if (!m_archive.close() || m_failed) {
+        m_saveFile->cancelWriting();
+        return false;
+    }
+
+    return m_saveFile->commit();
+}
+
+}
+}
@@ -0,0 +1,107 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LAYOUTSARCHIVE_H
+#define LAYOUTSARCHIVE_H
+
+// Qt
+#include <QByteArray>
+#include <QMap>
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+
+// KDE
+#include <KArchive/KTar>
+
+class KArchiveDirectory;
+class KArchiveFile;
+class QSaveFile;
+
+namespace Latte {
+namespace Layouts {
+
+//! Reads latte tar archives (*.latterc) entry by entry. Entries are
+//! inspected in place through their archive devices and are only written
+//! to disk when they are explicitly extracted to their final destination,
+//! so validating an archive never needs a temporary extraction directory.
+class ArchiveReader
+{
+public:
+    ArchiveReader(const QString &file);
+    ~ArchiveReader();
+
+    bool isOpen() const;
+
+    bool hasFile(const QString &path) const;
+    bool hasDirectory(const QString &path) const;
+
+    //! names of the entries found at the root of the archive
+    QStringList rootEntries() const;
+
+    //! reads the key/value pairs of a top level group from a kconfig file
+    //! that is stored in the archive, the entry is parsed through KConfig
+    //! from a temporary copy so escaped values are read correctly
+    QMap<QString, QString> readConfigGroup(const QString &path, const QString &group) const;
+    QString readConfigEntry(const QString &path, const QString &group, const QString &key, const QString &defaultValue = QString()) const;
+
+    //! streams a file entry to destinationFile, the destination is replaced atomically
+    bool extractFile(const QString &path, const QString &destinationFile) const;
+    //! streams all the files of a directory entry recursively under destinationPath
+    bool extractDirectory(const QString &path, const QString &destinationPath) const;
+
+private:
+    const KArchiveFile *file(const QString &path) const;
+    const KArchiveDirectory *directory(const QString &path) const;
+
+    bool extractDirectory(const KArchiveDirectory *dir, const QString &destinationPath) const;
+
+private:
+    KTar m_archive;
+};
+
+//! Writes latte tar archives by streaming local files into the archive.
+//! The archive file is only replaced when it has been completely written.
+class ArchiveWriter
+{
+public:
+    ArchiveWriter(const QString &file);
+    ~ArchiveWriter();
+
+    bool isOpen() const;
+
+    bool addFile(const QString &localFile, const QString &archivePath);
+    bool addData(const QString &archivePath, const QByteArray &data);
+
+    //! finalizes the archive, the archive file is replaced only when all
+    //! the writes succeeded and otherwise it is left untouched
+    bool close();
+
+private:
+    bool m_failed{false};
+
+    //! it must be declared before the archive that writes through it
+    QScopedPointer<QSaveFile> m_saveFile;
+    KTar m_archive;
+};
+
+}
+}
+
+#endif
@@ -21,6 +21,7 @@
 #include "importer.h"
 
 // local
+#include "archive.h"
 #include "manager.h"
 #include "../lattecorona.h"
 #include "../screenpool.h"
@@ -33,9 +34,6 @@
 #include <QTemporaryDir>
 
 // KDE
-#include <KArchive/KTar>
-#include <KArchive/KArchiveEntry>
-#include <KArchive/KArchiveDirectory>
 #include <KConfigGroup>
 #include <KLocalizedString>
 #include <KNotification>
@@ -296,54 +294,35 @@ bool Importer::importOldConfiguration(QString oldConfigPath, QString newName)
         return false;
     }
 
-    KTar archive(oldConfigPath, QStringLiteral("application/x-tar"));
-    archive.open(QIODevice::ReadOnly);
+    ArchiveReader archive(oldConfigPath);
 
     if (!archive.isOpen()) {
         return false;
     }
 
-    auto rootDir = archive.directory();
-    QTemporaryDir uniqueTempDir;
-    QDir tempDir{uniqueTempDir.path()};
-
-    qDebug() << "temp layout directory : " << tempDir.absolutePath();
-
-    if (rootDir) {
-        if (!tempDir.exists())
-            tempDir.mkpath(tempDir.absolutePath());
-
-        for(const auto &name : rootDir->entries()) {
-            auto fileEntry = rootDir->file(name);
-
-            if (fileEntry && (fileEntry->name() == "lattedockrc"
-                              || fileEntry->name() == "lattedock-appletsrc")) {
-                if (!fileEntry->copyTo(tempDir.absolutePath())) {
-                    qInfo() << i18nc("import/export config", "The extracted file could not be copied!!!");
-                    archive.close();
-                    return false;
-                }
-            } else {
-                qInfo() << i18nc("import/export config", "The file has a wrong format!!!");
-                archive.close();
-                return false;
-            }
+    for(const auto &name : archive.rootEntries()) {
+        if (name != "lattedockrc" && name != "lattedock-appletsrc") {
+            qInfo() << i18nc("import/export config", "The file has a wrong format!!!");
+            return false;
         }
-    } else {
-        qInfo() << i18nc("import/export config", "The temp directory could not be created!!!");
-        archive.close();
+    }
+
+    if (!archive.hasFile("lattedockrc") || !archive.hasFile("lattedock-appletsrc")) {
         return false;
     }
 
-    //! only if the above has passed we must process the files
-    QString appletsPath(tempDir.absolutePath() + "/lattedock-appletsrc");
-    QString screensPath(tempDir.absolutePath() + "/lattedockrc");
+    //! only the applets file needs to be extracted because its containments
+    //! are copied through KConfig, the screens are read directly from the archive
+    QTemporaryDir uniqueTempDir;
+    QString appletsPath(uniqueTempDir.path() + "/lattedock-appletsrc");
+
+    qDebug() << "temp layout directory : " << uniqueTempDir.path();
 
-    if (!QFile(appletsPath).exists() || !QFile(screensPath).exists()) {
+    if (!uniqueTempDir.isValid() || !archive.extractFile("lattedock-appletsrc", appletsPath)) {
+        qInfo() << i18nc("import/export config", "The extracted file could not be copied!!!");
         return false;
     }
 
-
     if (newName.isEmpty()) {
         int lastSlash = oldConfigPath.lastIndexOf("/");
         newName = oldConfigPath.remove(0, lastSlash + 1);
@@ -357,12 +336,11 @@ bool Importer::importOldConfiguration(QString oldConfigPath, QString newName)
     }
 
     //! the old configuration contains also screen values, these must be updated also
-    KSharedConfigPtr oldScreensConfig = KSharedConfig::openConfig(screensPath);
-    KConfigGroup m_screensGroup = KConfigGroup(oldScreensConfig, "ScreenConnectors");
+    const QMap<QString, QString> screenConnectors = archive.readConfigGroup("lattedockrc", "ScreenConnectors");
 
     //restore the known ids to connector mappings
-    for(const QString &key : m_screensGroup.keyList()) {
-        QString connector = m_screensGroup.readEntry(key, QString());
+    for(const QString &key : screenConnectors.keys()) {
+        QString connector = screenConnectors[key];
         int id = key.toInt();
 
         if (id >= 10 && !m_manager->corona()->screenPool()->knownIds().contains(id)) {
@@ -375,27 +353,25 @@ bool Importer::importOldConfiguration(QString oldConfigPath, QString newName)
 
 bool Importer::exportFullConfiguration(QString file)
 {
-    if (QFile::exists(file) && !QFile::remove(file)) {
+    //! the previous file is replaced only when the new archive has been written successfully
+    ArchiveWriter archive(file);
+
+    if (!archive.isOpen()) {
         return false;
     }
 
-    KTar archive(file, QStringLiteral("application/x-tar"));
+    const QString lattedockrc = QDir::homePath() + "/.config/lattedockrc";
 
-    if (!archive.open(QIODevice::WriteOnly)) {
-        return false;
+    //! lattedockrc is not created before the universal settings are changed
+    if (QFileInfo::exists(lattedockrc)) {
+        archive.addFile(lattedockrc, QStringLiteral("lattedockrc"));
     }
 
-    archive.addLocalFile(QString(QDir::homePath() + "/.config/lattedockrc"), QStringLiteral("lattedockrc"));
-
     for(const auto &layoutName : availableLayouts()) {
-        archive.addLocalFile(layoutFilePath(layoutName), QString("latte/" + layoutName + ".layout.latte"));
+        archive.addFile(layoutFilePath(layoutName), QString("latte/" + layoutName + ".layout.latte"));
     }
 
-    //archive.addLocalDirectory(QString(QDir::homePath() + "/.config/latte"), QStringLiteral("latte"));
-
-    archive.close();
-
-    return true;
+    return archive.close();
 }
 
 Importer::LatteFileVersion Importer::fileVersion(QString file)
@@ -418,33 +394,23 @@ Importer::LatteFileVersion Importer::fileVersion(QString file)
         return Importer::UnknownFileType;
     }
 
-    KTar archive(file, QStringLiteral("application/x-tar"));
-    archive.open(QIODevice::ReadOnly);
+    ArchiveReader archive(file);
 
     //! if the file isnt a tar archive
     if (!archive.isOpen()) {
         return Importer::UnknownFileType;
     }
 
-    QTemporaryDir archiveTempDir;
-
+    //! the archive entries are inspected in place, nothing is extracted
     bool version1rc = false;
     bool version1applets = false;
 
     bool version2rc = false;
     bool version2LatteDir = false;
-    bool version2layout = false;
-
-    archive.directory()->copyTo(archiveTempDir.path());
-
 
     //rc file
-    QString rcFile(archiveTempDir.path() + "/lattedockrc");
-
-    if (QFile(rcFile).exists()) {
-        KSharedConfigPtr lConfig = KSharedConfig::openConfig(rcFile);
-        KConfigGroup universalGroup = KConfigGroup(lConfig, "UniversalSettings");
-        int version = universalGroup.readEntry("version", 1);
+    if (archive.hasFile("lattedockrc")) {
+        int version = archive.readConfigEntry("lattedockrc", "UniversalSettings", "version", "1").toInt();
 
         if (version == 1) {
             version1rc = true;
@@ -454,28 +420,20 @@ Importer::LatteFileVersion Importer::fileVersion(QString file)
     }
 
     //applets file
-    QString appletsFile(archiveTempDir.path() + "/lattedock-appletsrc");
-
-    if (QFile(appletsFile).exists() && version1rc) {
-        KSharedConfigPtr lConfig = KSharedConfig::openConfig(appletsFile);
-        KConfigGroup generalGroup = KConfigGroup(lConfig, "LayoutSettings");
-        int version = generalGroup.readEntry("version", 1);
+    if (version1rc && archive.hasFile("lattedock-appletsrc")) {
+        int version = archive.readConfigEntry("lattedock-appletsrc", "LayoutSettings", "version", "1").toInt();
 
         if (version == 1) {
             version1applets = true;
-        } else if (version == 2) {
-            version2layout = true;
         }
     }
 
     //latte directory
-    QString latteDir(archiveTempDir.path() + "/latte");
-
-    if (QDir(latteDir).exists()) {
+    if (archive.hasDirectory("latte")) {
         version2LatteDir = true;
     }
 
-    if (version1applets && version1applets) {
+    if (version1rc && version1applets) {
         return ConfigVersion1;
     } else if (version2rc && version2LatteDir) {
         return ConfigVersion2;
@@ -492,21 +450,30 @@ bool Importer::importHelper(QString fileName)
         return false;
     }
 
-    KTar archive(fileName, QStringLiteral("application/x-tar"));
-    archive.open(QIODevice::ReadOnly);
+    ArchiveReader archive(fileName);
 
     if (!archive.isOpen()) {
         return false;
     }
 
-    QString latteDirPath(QDir::homePath() + "/.config/latte");
+    QString configPath(QDir::homePath() + "/.config");
+    QString latteDirPath(configPath + "/latte");
     QDir latteDir(latteDirPath);
 
     if (latteDir.exists()) {
         latteDir.removeRecursively();
     }
 
-    archive.directory()->copyTo(QString(QDir::homePath() + "/.config"));
+    //! entries are streamed straight to their final place under ~/.config
+    for(const auto &name : archive.rootEntries()) {
+        bool extracted = archive.hasDirectory(name) ? archive.extractDirectory(name, configPath + "/" + name)
+                                                    : archive.extractFile(name, configPath + "/" + name);
+
+        if (!extracted) {
+            qInfo() << i18nc("import/export config", "The extracted file could not be copied!!!");
+            return false;
+        }
+    }
 
     return true;
 }
@@ -21,17 +21,7 @@
 #include "launcherssignals.h"
 
 // local
-#include "../lattecorona.h"
-#include "../layout/centrallayout.h"
 #include "../layouts/manager.h"
-#include "../layouts/synchronizer.h"
-
-// Qt
-#include <QQuickItem>
-
-// Plasma
-#include <Plasma/Applet>
-#include <Plasma/Containment>
 
 namespace Latte {
 namespace Layouts {
@@ -46,270 +36,165 @@ LaunchersSignals::~LaunchersSignals()
 {
 }
 
-QList<Plasma::Applet *> LaunchersSignals::lattePlasmoids(QString layoutName)
+LaunchersSignals::Receivers LaunchersSignals::receiversFor(QQuickItem *plasmoid) const
 {
-    QList<Plasma::Applet *> applets;
-
-    CentralLayout *layout = m_manager->synchronizer()->centralLayout(layoutName);
-    QList<Plasma::Containment *> containments;
+    Receivers receivers;
+    const QMetaObject *metaObject = plasmoid->metaObject();
+
+    auto method = [&metaObject](const char *signature) {
+        int methodIndex = metaObject->indexOfMethod(signature);
+        return methodIndex >= 0 ? metaObject->method(methodIndex) : QMetaMethod();
+    };
+
+    receivers.addLauncher = method("extSignalAddLauncher(QVariant,QVariant)");
+    receivers.removeLauncher = method("extSignalRemoveLauncher(QVariant,QVariant)");
+    receivers.addLauncherToActivity = method("extSignalAddLauncherToActivity(QVariant,QVariant,QVariant)");
+    receivers.removeLauncherFromActivity = method("extSignalRemoveLauncherFromActivity(QVariant,QVariant,QVariant)");
+    receivers.urlsDropped = method("extSignalUrlsDropped(QVariant,QVariant)");
+    receivers.moveTask = method("extSignalMoveTask(QVariant,QVariant,QVariant)");
+    receivers.validateLaunchersOrder = method("extSignalValidateLaunchersOrder(QVariant,QVariant)");
+
+    return receivers;
+}
 
-    if (layoutName.isEmpty()) {
-        containments = m_manager->corona()->containments();
-    } else if (layout) {
-        containments = *(layout->containments());
+void LaunchersSignals::subscribe(int appletId, QString layoutName, int launcherGroup, QQuickItem *plasmoid)
+{
+    if (!plasmoid) {
+        unsubscribe(appletId);
+        return;
     }
 
-    for(const auto containment : containments) {
-        for(auto *applet : containment->applets()) {
-            KPluginMetaData meta = applet->kPackage().metadata();
+    Types::LaunchersGroup group = static_cast<Types::LaunchersGroup>(launcherGroup);
+    bool newPlasmoid{true};
+
+    if (m_subscribers.contains(appletId)) {
+        const Subscriber &current = m_subscribers[appletId];
 
-            if (meta.pluginId() == "org.kde.latte.plasmoid") {
-                applets.append(applet);
-            }
+        if (current.plasmoid == plasmoid && current.layoutName == layoutName && current.group == group) {
+            return;
         }
-    }
 
-    return applets;
-}
+        newPlasmoid = (current.plasmoid != plasmoid);
 
-void LaunchersSignals::addLauncher(QString layoutName, int launcherGroup, QString launcher)
-{
-    Types::LaunchersGroup group = static_cast<Types::LaunchersGroup>(launcherGroup);
-
-    if ((Types::LaunchersGroup)group == Types::UniqueLaunchers) {
-        return;
+        if (current.plasmoid && newPlasmoid) {
+            disconnect(current.plasmoid, &QObject::destroyed, this, nullptr);
+        }
     }
 
-    QString lName = (group == Types::LayoutLaunchers) ? layoutName : "";
-
-    for(const auto applet : lattePlasmoids(lName)) {
-        if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-            const auto &childItems = appletInterface->childItems();
-
-            if (childItems.isEmpty()) {
-                continue;
-            }
+    Subscriber subscriber;
+    subscriber.appletId = appletId;
+    subscriber.layoutName = layoutName;
+    subscriber.group = group;
+    subscriber.plasmoid = plasmoid;
+    subscriber.receivers = newPlasmoid ? receiversFor(plasmoid) : m_subscribers[appletId].receivers;
 
-            for (QQuickItem *item : childItems) {
-                if (auto *metaObject = item->metaObject()) {
-                    int methodIndex = metaObject->indexOfMethod("extSignalAddLauncher(QVariant,QVariant)");
+    m_subscribers[appletId] = subscriber;
+    m_routesDirty = true;
 
-                    if (methodIndex == -1) {
-                        continue;
-                    }
+    if (newPlasmoid) {
+        connect(plasmoid, &QObject::destroyed, this, [this, appletId]() {
+            unsubscribe(appletId);
+        });
+    }
+}
 
-                    QMetaMethod method = metaObject->method(methodIndex);
-                    method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher));
-                }
-            }
-        }
+void LaunchersSignals::unsubscribe(int appletId)
+{
+    if (m_subscribers.remove(appletId) > 0) {
+        m_routesDirty = true;
     }
 }
 
-void LaunchersSignals::removeLauncher(QString layoutName, int launcherGroup, QString launcher)
+QList<LaunchersSignals::Subscriber> LaunchersSignals::subscribers(QString layoutName, int launcherGroup)
 {
     Types::LaunchersGroup group = static_cast<Types::LaunchersGroup>(launcherGroup);
 
-    if ((Types::LaunchersGroup)group == Types::UniqueLaunchers) {
-        return;
+    if (group == Types::UniqueLaunchers) {
+        return QList<Subscriber>();
     }
 
-    QString lName = (group == Types::LayoutLaunchers) ? layoutName : "";
-
-    for(const auto applet : lattePlasmoids(lName)) {
-        if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-            const auto &childItems = appletInterface->childItems();
+    if (m_routesDirty) {
+        m_routes.clear();
 
-            if (childItems.isEmpty()) {
-                continue;
+        for (const auto &subscriber : m_subscribers) {
+            if (subscriber.group == Types::GlobalLaunchers) {
+                m_routes[Types::GlobalLaunchers][""] << subscriber;
+            } else if (subscriber.group == Types::LayoutLaunchers) {
+                m_routes[Types::LayoutLaunchers][subscriber.layoutName] << subscriber;
             }
+        }
 
-            for (QQuickItem *item : childItems) {
-                if (auto *metaObject = item->metaObject()) {
-                    int methodIndex = metaObject->indexOfMethod("extSignalRemoveLauncher(QVariant,QVariant)");
+        m_routesDirty = false;
+    }
 
-                    if (methodIndex == -1) {
-                        continue;
-                    }
+    QString lName = (group == Types::LayoutLaunchers) ? layoutName : "";
 
-                    QMetaMethod method = metaObject->method(methodIndex);
-                    method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher));
-                }
-            }
+    //! a copy is returned because subscribers may change while they are informed
+    return m_routes.value(group).value(lName);
+}
+
+void LaunchersSignals::addLauncher(QString layoutName, int launcherGroup, QString launcher)
+{
+    for (const auto &subscriber : subscribers(layoutName, launcherGroup)) {
+        if (subscriber.plasmoid) {
+            subscriber.receivers.addLauncher.invoke(subscriber.plasmoid, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher));
         }
     }
 }
 
-void LaunchersSignals::addLauncherToActivity(QString layoutName, int launcherGroup, QString launcher, QString activity)
+void LaunchersSignals::removeLauncher(QString layoutName, int launcherGroup, QString launcher)
 {
-    Types::LaunchersGroup group = static_cast<Types::LaunchersGroup>(launcherGroup);
-
-    if ((Types::LaunchersGroup)group == Types::UniqueLaunchers) {
-        return;
+    for (const auto &subscriber : subscribers(layoutName, launcherGroup)) {
+        if (subscriber.plasmoid) {
+            subscriber.receivers.removeLauncher.invoke(subscriber.plasmoid, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher));
+        }
     }
+}
 
-    QString lName = (group == Types::LayoutLaunchers) ? layoutName : "";
-
-    for(const auto applet : lattePlasmoids(lName)) {
-        if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-            const auto &childItems = appletInterface->childItems();
-
-            if (childItems.isEmpty()) {
-                continue;
-            }
-
-            for (QQuickItem *item : childItems) {
-                if (auto *metaObject = item->metaObject()) {
-                    int methodIndex = metaObject->indexOfMethod("extSignalAddLauncherToActivity(QVariant,QVariant,QVariant)");
-
-                    if (methodIndex == -1) {
-                        continue;
-                    }
-
-                    QMetaMethod method = metaObject->method(methodIndex);
-                    method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher), Q_ARG(QVariant, activity));
-                }
-            }
+void LaunchersSignals::addLauncherToActivity(QString layoutName, int launcherGroup, QString launcher, QString activity)
+{
+    for (const auto &subscriber : subscribers(layoutName, launcherGroup)) {
+        if (subscriber.plasmoid) {
+            subscriber.receivers.addLauncherToActivity.invoke(subscriber.plasmoid, Q_ARG(QVariant, launcherGroup),
+                                                              Q_ARG(QVariant, launcher), Q_ARG(QVariant, activity));
         }
     }
 }
 
 void LaunchersSignals::removeLauncherFromActivity(QString layoutName, int launcherGroup, QString launcher, QString activity)
 {
-    Types::LaunchersGroup group = static_cast<Types::LaunchersGroup>(launcherGroup);
-
-    if ((Types::LaunchersGroup)group == Types::UniqueLaunchers) {
-        return;
-    }
-
-    QString lName = (group == Types::LayoutLaunchers) ? layoutName : "";
-
-    for(const auto applet : lattePlasmoids(lName)) {
-        if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-            const auto &childItems = appletInterface->childItems();
-
-            if (childItems.isEmpty()) {
-                continue;
-            }
-
-            for (QQuickItem *item : childItems) {
-                if (auto *metaObject = item->metaObject()) {
-                    int methodIndex = metaObject->indexOfMethod("extSignalRemoveLauncherFromActivity(QVariant,QVariant,QVariant)");
-
-                    if (methodIndex == -1) {
-                        continue;
-                    }
-
-                    QMetaMethod method = metaObject->method(methodIndex);
-                    method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launcher), Q_ARG(QVariant, activity));
-                }
-            }
+    for (const auto &subscriber : subscribers(layoutName, launcherGroup)) {
+        if (subscriber.plasmoid) {
+            subscriber.receivers.removeLauncherFromActivity.invoke(subscriber.plasmoid, Q_ARG(QVariant, launcherGroup),
+                                                                   Q_ARG(QVariant, launcher), Q_ARG(QVariant, activity));
         }
     }
 }
 
 void LaunchersSignals::urlsDropped(QString layoutName, int launcherGroup, QStringList urls)
 {
-    Types::LaunchersGroup group = static_cast<Types::LaunchersGroup>(launcherGroup);
-
-    if ((Types::LaunchersGroup)group == Types::UniqueLaunchers) {
-        return;
-    }
-
-    QString lName = (group == Types::LayoutLaunchers) ? layoutName : "";
-
-    for(const auto applet : lattePlasmoids(lName)) {
-        if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-            const auto &childItems = appletInterface->childItems();
-
-            if (childItems.isEmpty()) {
-                continue;
-            }
-
-            for (QQuickItem *item : childItems) {
-                if (auto *metaObject = item->metaObject()) {
-                    int methodIndex = metaObject->indexOfMethod("extSignalUrlsDropped(QVariant,QVariant)");
-
-                    if (methodIndex == -1) {
-                        continue;
-                    }
-
-                    QMetaMethod method = metaObject->method(methodIndex);
-                    method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, urls));
-                }
-            }
+    for (const auto &subscriber : subscribers(layoutName, launcherGroup)) {
+        if (subscriber.plasmoid) {
+            subscriber.receivers.urlsDropped.invoke(subscriber.plasmoid, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, urls));
         }
     }
 }
 
 void LaunchersSignals::moveTask(QString layoutName, int senderId, int launcherGroup, int from, int to)
 {
-    Types::LaunchersGroup group = static_cast<Types::LaunchersGroup>(launcherGroup);
-
-    if ((Types::LaunchersGroup)group == Types::UniqueLaunchers) {
-        return;
-    }
-
-    QString lName = (group == Types::LayoutLaunchers) ? layoutName : "";
-
-    for(const auto applet : lattePlasmoids(lName)) {
-        if (applet->id() != senderId) {
-            if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-                const auto &childItems = appletInterface->childItems();
-
-                if (childItems.isEmpty()) {
-                    continue;
-                }
-
-                for (QQuickItem *item : childItems) {
-                    if (auto *metaObject = item->metaObject()) {
-                        int methodIndex = metaObject->indexOfMethod("extSignalMoveTask(QVariant,QVariant,QVariant)");
-
-                        if (methodIndex == -1) {
-                            continue;
-                        }
-
-                        QMetaMethod method = metaObject->method(methodIndex);
-                        method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, from), Q_ARG(QVariant, to));
-                    }
-                }
-            }
+    for (const auto &subscriber : subscribers(layoutName, launcherGroup)) {
+        if (subscriber.appletId != senderId && subscriber.plasmoid) {
+            subscriber.receivers.moveTask.invoke(subscriber.plasmoid, Q_ARG(QVariant, launcherGroup),
+                                                 Q_ARG(QVariant, from), Q_ARG(QVariant, to));
         }
     }
 }
 
 void LaunchersSignals::validateLaunchersOrder(QString layoutName, int senderId, int launcherGroup, QStringList launchers)
 {
-    Types::LaunchersGroup group = static_cast<Types::LaunchersGroup>(launcherGroup);
-
-    if ((Types::LaunchersGroup)group == Types::UniqueLaunchers) {
-        return;
-    }
-
-    QString lName = (group == Types::LayoutLaunchers) ? layoutName : "";
-
-    for(const auto applet : lattePlasmoids(lName)) {
-        if (applet->id() != senderId) {
-            if (QQuickItem *appletInterface = applet->property("_plasma_graphicObject").value<QQuickItem *>()) {
-                const auto &childItems = appletInterface->childItems();
-
-                if (childItems.isEmpty()) {
-                    continue;
-                }
-
-                for (QQuickItem *item : childItems) {
-                    if (auto *metaObject = item->metaObject()) {
-                        int methodIndex = metaObject->indexOfMethod("extSignalValidateLaunchersOrder(QVariant,QVariant)");
-
-                        if (methodIndex == -1) {
-                            continue;
-                        }
-
-                        QMetaMethod method = metaObject->method(methodIndex);
-                        method.invoke(item, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launchers));
-                    }
-                }
-            }
+    for (const auto &subscriber : subscribers(layoutName, launcherGroup)) {
+        if (subscriber.appletId != senderId && subscriber.plasmoid) {
+            subscriber.receivers.validateLaunchersOrder.invoke(subscriber.plasmoid, Q_ARG(QVariant, launcherGroup), Q_ARG(QVariant, launchers));
         }
     }
 }
@@ -25,11 +25,12 @@
 #include "../liblatte2/types.h"
 
 // Qt
+#include <QHash>
+#include <QList>
+#include <QMetaMethod>
 #include <QObject>
-
-namespace Plasma {
-class Applet;
-}
+#include <QPointer>
+#include <QQuickItem>
 
 namespace Latte {
 namespace Layouts {
@@ -45,7 +46,11 @@ namespace Layouts {
 //! there are changes in their models. This way we are trying to avoid
 //! crashes that occur by setting the launcherList of the tasksModel so
 //! often. The plasma devs of libtaskmanager have designed the launchers
-//! model to be initialized only once during startup
+//! model to be initialized only once during startup.
+//!
+//! Tasks plasmoids subscribe once with their layout and launchers group
+//! and the messages are routed only to the matching subscribers. Their
+//! receiving methods are resolved once during subscription.
 class LaunchersSignals : public QObject
 {
     Q_OBJECT
@@ -64,10 +69,41 @@ public slots:
     Q_INVOKABLE void moveTask(QString layoutName, int senderId, int launcherGroup, int from, int to);
     Q_INVOKABLE void validateLaunchersOrder(QString layoutName, int senderId, int launcherGroup, QStringList launchers);
 
+    //! plasmoid is subscribing again when its layout or launchers group changes
+    Q_INVOKABLE void subscribe(int appletId, QString layoutName, int launcherGroup, QQuickItem *plasmoid);
+    Q_INVOKABLE void unsubscribe(int appletId);
+
 private:
-    QList<Plasma::Applet *> lattePlasmoids(QString layoutName);
+    struct Receivers {
+        QMetaMethod addLauncher;
+        QMetaMethod removeLauncher;
+        QMetaMethod addLauncherToActivity;
+        QMetaMethod removeLauncherFromActivity;
+        QMetaMethod urlsDropped;
+        QMetaMethod moveTask;
+        QMetaMethod validateLaunchersOrder;
+    };
+
+    struct Subscriber {
+        int appletId{-1};
+        QString layoutName;
+        Types::LaunchersGroup group{Types::UniqueLaunchers};
+        QPointer<QQuickItem> plasmoid;
+        Receivers receivers;
+    };
+
+    Receivers receiversFor(QQuickItem *plasmoid) const;
+    //! the subscribers that must be informed for a layout/group message
+    QList<Subscriber> subscribers(QString layoutName, int launcherGroup);
 
 private:
+    QHash<int, Subscriber> m_subscribers;
+
+    //! cached routes, group -> layout name -> subscribers, global
+    //! launchers are using an empty layout name
+    bool m_routesDirty{true};
+    QHash<int, QHash<QString, QList<Subscriber>>> m_routes;
+
     Layouts::Manager *m_manager{nullptr};
 };
 
@@ -25,8 +25,10 @@
 // local
 #include "importer.h"
 #include "launcherssignals.h"
+#include "persistence.h"
 #include "../infoview.h"
 #include "../screenpool.h"
+#include "../startuptracer.h"
 #include "../layout/abstractlayout.h"
 #include "../layout/centrallayout.h"
 #include "../settings/settingsdialog.h"
@@ -49,14 +51,20 @@ const int MultipleLayoutsPresetId = 10;
 Manager::Manager(QObject *parent)
     : QObject(parent),
       m_importer(new Importer(this)),
-      m_launchersSignals(new LaunchersSignals(this))
+      m_launchersSignals(new LaunchersSignals(this)),
+      m_persistence(new Persistence(this))
 {
     m_corona = qobject_cast<Latte::Corona *>(parent);
     //! needs to be created AFTER corona assignment
     m_synchronizer = new Synchronizer(this);
 
     if (m_corona) {
+        m_persistence->setSyncInterval(m_corona->universalSettings()->syncInterval());
+
         connect(m_corona->universalSettings(), &UniversalSettings::currentLayoutNameChanged, this, &Manager::currentLayoutNameChanged);
+        connect(m_corona->universalSettings(), &UniversalSettings::syncIntervalChanged, this, [&]() {
+            m_persistence->setSyncInterval(m_corona->universalSettings()->syncInterval());
+        });
 
         connect(m_synchronizer, &Synchronizer::centralLayoutsChanged, this, &Manager::centralLayoutsChanged);
         connect(m_synchronizer, &Synchronizer::currentLayoutNameChanged, this, &Manager::currentLayoutNameChanged);
@@ -70,6 +78,7 @@ Manager::~Manager()
 {
     m_importer->deleteLater();
     m_launchersSignals->deleteLater();
+    m_persistence->deleteLater();
 
     //! no needed because Latte:Corona is calling it at better place
     // unload();
@@ -119,6 +128,9 @@ void Manager::load()
 
 void Manager::unload()
 {
+    //! write all pending changes before the layouts are unloaded
+    m_persistence->flush();
+
     m_synchronizer->unloadLayouts();
 
     //! Remove no-needed temp files
@@ -152,6 +164,11 @@ LaunchersSignals *Manager::launchersSignals() const
     return m_launchersSignals;
 }
 
+Persistence *Manager::persistence() const
+{
+    return m_persistence;
+}
+
 Synchronizer *Manager::synchronizer() const
 {
     return m_synchronizer;
@@ -235,6 +252,8 @@ bool Manager::switchToLayout(QString layoutName, int previousMemoryUsage)
 
 void Manager::loadLayoutOnStartup(QString layoutName)
 {
+    StartupTracer::Span span(QStringLiteral("layouts: load layout on startup"));
+
     QStringList layouts = m_importer->checkRepairMultipleLayoutsLinkedFile();
 
     //! Latte didn't close correctly, maybe a crash
@@ -23,6 +23,7 @@
 
 // local
 #include "launcherssignals.h"
+#include "persistence.h"
 #include "synchronizer.h"
 #include "settings/settingsdialog.h"
 
@@ -45,6 +46,7 @@ class CentralLayout;
 namespace Layouts {
 class Importer;
 class LaunchersSignals;
+class Persistence;
 class Synchronizer;
 }
 }
@@ -102,6 +104,7 @@ public:
     //! returns the current and central layout based on activities and user preferences
     CentralLayout *currentLayout() const;
     LaunchersSignals *launchersSignals() const;
+    Persistence *persistence() const;
     Synchronizer *synchronizer() const;
 
     void importDefaultLayout(bool newInstanceIfPresent = false);
@@ -154,6 +157,7 @@ private:
     Latte::Corona *m_corona{nullptr};
     Importer *m_importer{nullptr};
     LaunchersSignals *m_launchersSignals{nullptr};
+    Persistence *m_persistence{nullptr};
     Synchronizer *m_synchronizer{nullptr};
 
     friend class Latte::SettingsDialog;
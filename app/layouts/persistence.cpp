@@ -0,0 +1,133 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "persistence.h"
+
+// local
+#include "../layout/genericlayout.h"
+
+// Qt
+#include <QDebug>
+
+namespace Latte {
+namespace Layouts {
+
+Persistence::Persistence(QObject *parent)
+    : QObject(parent)
+{
+    //! the timer is not restarted for every change, this way a write
+    //! always happens at most syncInterval after the first change
+    m_syncTimer.setSingleShot(true);
+    m_syncTimer.setInterval(1000);
+    connect(&m_syncTimer, &QTimer::timeout, this, &Persistence::flush);
+}
+
+Persistence::~Persistence()
+{
+    flush();
+}
+
+bool Persistence::hasPendingWrites() const
+{
+    return !m_dirtyLayouts.isEmpty() || !m_dirtyGroups.isEmpty();
+}
+
+int Persistence::syncInterval() const
+{
+    return m_syncTimer.interval();
+}
+
+void Persistence::setSyncInterval(int interval)
+{
+    m_syncTimer.setInterval(qMax(0, interval));
+}
+
+void Persistence::markDirty(Layout::GenericLayout *layout)
+{
+    if (!layout) {
+        return;
+    }
+
+    for (const auto &dirty : m_dirtyLayouts) {
+        if (dirty == layout) {
+            scheduleFlush();
+            return;
+        }
+    }
+
+    m_dirtyLayouts << QPointer<Layout::GenericLayout>(layout);
+    scheduleFlush();
+}
+
+void Persistence::markDirty(const KConfigGroup &group)
+{
+    if (!group.isValid()) {
+        return;
+    }
+
+    for (const auto &dirty : m_dirtyGroups) {
+        if (dirty.config() == group.config()) {
+            scheduleFlush();
+            return;
+        }
+    }
+
+    m_dirtyGroups << group;
+    scheduleFlush();
+}
+
+void Persistence::scheduleFlush()
+{
+    if (m_syncTimer.interval() == 0) {
+        flush();
+    } else if (!m_syncTimer.isActive()) {
+        m_syncTimer.start();
+    }
+}
+
+void Persistence::flush()
+{
+    m_syncTimer.stop();
+
+    //! layouts are synced first because they may mark their config
+    //! groups dirty also
+    const QList<QPointer<Layout::GenericLayout>> layouts = m_dirtyLayouts;
+    m_dirtyLayouts.clear();
+
+    for (const auto &layout : layouts) {
+        if (layout) {
+            layout->syncToLayoutFile(false);
+        }
+    }
+
+    const QList<KConfigGroup> groups = m_dirtyGroups;
+    m_dirtyGroups.clear();
+
+    //! KConfigGroup::sync() saves the entire config file atomically
+    for (auto group : groups) {
+        group.sync();
+    }
+
+    if (!layouts.isEmpty() || !groups.isEmpty()) {
+        qDebug() << "persistence :: flushed" << layouts.count() << "layouts and" << groups.count() << "config files...";
+    }
+}
+
+}
+}
@@ -0,0 +1,83 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LAYOUTSPERSISTENCE_H
+#define LAYOUTSPERSISTENCE_H
+
+// Qt
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+// KDE
+#include <KConfigGroup>
+
+namespace Latte {
+namespace Layout {
+class GenericLayout;
+}
+}
+
+namespace Latte {
+namespace Layouts {
+
+//! Layouts::Persistence is a write-behind layer for all configuration
+//! files that are updated while Latte is running. Callers just mark
+//! a layout or a config group as dirty and all the pending writes are
+//! coalesced into one save per file when the sync window expires.
+//! Pending writes are flushed immediately on layout switching and
+//! when the application is closing.
+class Persistence : public QObject
+{
+    Q_OBJECT
+
+public:
+    Persistence(QObject *parent);
+    ~Persistence() override;
+
+    bool hasPendingWrites() const;
+
+    int syncInterval() const;
+    void setSyncInterval(int interval);
+
+    //! the layout containments must be synced back to its original layout file
+    void markDirty(Layout::GenericLayout *layout);
+    //! the config file that group belongs to must be synced to disk
+    void markDirty(const KConfigGroup &group);
+
+public slots:
+    //! write all pending changes to disk
+    void flush();
+
+private:
+    void scheduleFlush();
+
+private:
+    QList<QPointer<Layout::GenericLayout>> m_dirtyLayouts;
+    //! KConfigGroups keep their KSharedConfig alive until they are synced
+    QList<KConfigGroup> m_dirtyGroups;
+
+    QTimer m_syncTimer;
+};
+
+}
+}
+
+#endif
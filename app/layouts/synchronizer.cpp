@@ -369,6 +369,14 @@ Latte::View *Synchronizer::viewForContainment(Plasma::Containment *containment)
         }
     }
 
+    for (auto layout : m_prewarmedLayouts) {
+        Latte::View *view = layout->viewForContainment(containment);
+
+        if (view) {
+            return view;
+        }
+    }
+
     for (auto layout : m_sharedLayouts) {
         Latte::View *view = layout->viewForContainment(containment);
 
@@ -483,14 +491,18 @@ void Synchronizer::pauseLayout(QString layoutName)
 void Synchronizer::syncActiveLayoutsToOriginalFiles()
 {
     if (m_manager->memoryUsage() == Types::MultipleLayouts) {
+        //! the layouts are marked and written together with any other
+        //! pending change, this way each layout file is saved only once
         for (const auto layout : m_centralLayouts) {
-            layout->syncToLayoutFile();
+            m_manager->persistence()->markDirty(layout);
         }
 
         for (const auto layout : m_sharedLayouts) {
-            layout->syncToLayoutFile();
+            m_manager->persistence()->markDirty(layout);
         }
     }
+
+    m_manager->persistence()->flush();
 }
 
 void Synchronizer::syncLatteViewsToScreens()
@@ -526,6 +538,87 @@ void Synchronizer::unloadCentralLayout(CentralLayout *layout)
     }
 }
 
+bool Synchronizer::prewarmLayout(QString layoutName)
+{
+    int maxPrewarmed = m_manager->corona()->universalSettings()->maxPrewarmedLayouts();
+
+    if (m_manager->memoryUsage() != Types::MultipleLayouts || !m_multipleModeInitialized || maxPrewarmed <= 0
+            || centralLayout(layoutName) || layoutName == Layout::AbstractLayout::MultipleLayoutsName) {
+        return false;
+    }
+
+    for (const auto prewarmed : m_prewarmedLayouts) {
+        if (prewarmed->name() == layoutName) {
+            return true;
+        }
+    }
+
+    QString lPath = layoutPath(layoutName);
+
+    if (lPath.isEmpty()) {
+        return false;
+    }
+
+    CentralLayout *newLayout = new CentralLayout(this, lPath, layoutName);
+
+    //! orphaned layouts would be shown at the current activity and layouts that
+    //! depend on shared layouts change their shared views, they can not be prewarmed
+    if (newLayout->activities().isEmpty() || !newLayout->sharedLayoutName().isEmpty()
+            || newLayout->activities().contains(m_manager->corona()->activitiesConsumer()->currentActivity())) {
+        delete newLayout;
+        return false;
+    }
+
+    while (m_prewarmedLayouts.count() >= maxPrewarmed) {
+        discardPrewarmedLayout(m_prewarmedLayouts.first());
+    }
+
+    qDebug() << "PREWARMING LAYOUT ::::: " << layoutName;
+
+    m_prewarmedLayouts.append(newLayout);
+    newLayout->initToCorona(m_manager->corona());
+    newLayout->importToCorona();
+
+    return true;
+}
+
+CentralLayout *Synchronizer::takePrewarmedLayout(QString layoutName)
+{
+    for (int i = 0; i < m_prewarmedLayouts.count(); ++i) {
+        if (m_prewarmedLayouts[i]->name() == layoutName) {
+            return m_prewarmedLayouts.takeAt(i);
+        }
+    }
+
+    return nullptr;
+}
+
+void Synchronizer::discardPrewarmedLayout(CentralLayout *layout)
+{
+    if (!m_prewarmedLayouts.contains(layout)) {
+        return;
+    }
+
+    qDebug() << "DISCARDING PREWARMED LAYOUT ::::: " << layout->name();
+
+    m_prewarmedLayouts.removeAll(layout);
+
+    //! the original layout file is not touched because a prewarmed layout
+    //! was never shown to the user
+    layout->unloadLatteViews();
+    layout->unloadContainments();
+    m_manager->clearUnloadedContainmentsFromLinkedFile(layout->unloadedContainmentsIds(), true);
+
+    delete layout;
+}
+
+void Synchronizer::discardPrewarmedLayouts()
+{
+    while (!m_prewarmedLayouts.isEmpty()) {
+        discardPrewarmedLayout(m_prewarmedLayouts.first());
+    }
+}
+
 void Synchronizer::unloadSharedLayout(SharedLayout *layout)
 {
     if (m_sharedLayouts.contains(layout)) {
@@ -592,6 +685,8 @@ void Synchronizer::loadLayouts()
 
 void Synchronizer::unloadLayouts()
 {
+    discardPrewarmedLayouts();
+
     //! Unload all CentralLayouts
     while (!m_centralLayouts.isEmpty()) {
         CentralLayout *layout = m_centralLayouts.at(0);
@@ -676,6 +771,12 @@ bool Synchronizer::switchToLayout(QString layoutName, int previousMemoryUsage)
         if (m_manager->memoryUsage() == Types::SingleLayout) {
             //  emit currentLayoutIsSwitching(currentLayoutName());
         } else if (m_manager->memoryUsage() == Types::MultipleLayouts && layoutName != Layout::AbstractLayout::MultipleLayoutsName) {
+            //! the target layout views are built in the background while the switch
+            //! animation plays and its activities are starting
+            if (previousMemoryUsage == -1 && !centralLayout(layoutName) && layoutIsAssigned(layoutName)) {
+                prewarmLayout(layoutName);
+            }
+
             CentralLayout toLayout(this, lPath);
 
             QStringList toActivities = toLayout.activities();
@@ -701,6 +802,10 @@ bool Synchronizer::switchToLayout(QString layoutName, int previousMemoryUsage)
         //! sessions.
         QTimer::singleShot(350, [this, layoutName, lPath, previousMemoryUsage]() {
             qDebug() << layoutName << " - " << lPath;
+
+            //! all pending changes must reach the layout files before any layout is unloaded
+            m_manager->persistence()->flush();
+
             QString fixedLPath = lPath;
             QString fixedLayoutName = layoutName;
 
@@ -881,16 +986,21 @@ void Synchronizer::syncMultipleLayoutsToActivities(QString layoutForOrphans)
     //! Add needed Layouts based on Activities
     for (const auto &layoutName : layoutsToLoad) {
         if (!centralLayout(layoutName)) {
-            CentralLayout *newLayout = new CentralLayout(this, QString(layoutPath(layoutName)), layoutName);
+            CentralLayout *newLayout = takePrewarmedLayout(layoutName);
 
             if (newLayout) {
+                //! its views are already created, they just become part of the active layouts
+                qDebug() << "ACTIVATING PREWARMED LAYOUT ::::: " << layoutName;
+                m_centralLayouts.append(newLayout);
+            } else {
+                newLayout = new CentralLayout(this, QString(layoutPath(layoutName)), layoutName);
                 qDebug() << "ACTIVATING LAYOUT ::::: " << layoutName;
                 addLayout(newLayout);
                 newLayout->importToCorona();
+            }
 
-                if (m_manager->corona()->universalSettings()->showInfoWindow()) {
-                    m_manager->showInfoWindow(i18n("Activating layout: <b>%0</b> ...").arg(newLayout->name()), 5000, newLayout->appliedActivities());
-                }
+            if (m_manager->corona()->universalSettings()->showInfoWindow()) {
+                m_manager->showInfoWindow(i18n("Activating layout: <b>%0</b> ...").arg(newLayout->name()), 5000, newLayout->appliedActivities());
             }
         }
     }
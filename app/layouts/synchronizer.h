@@ -86,6 +86,10 @@ public:
     bool registerAtSharedLayout(CentralLayout *central, QString id);
     //! switch to specified layout, default previousMemoryUsage means that it didn't change
     bool switchToLayout(QString layoutName, int previousMemoryUsage = -1);
+    //! loads a layout and its views in the background, the views are bound to the
+    //! layout activities that are not current, so they stay hidden until the user
+    //! switches to them. Prewarming is only possible in MultipleLayouts mode
+    bool prewarmLayout(QString layoutName);
 
     int centralLayoutPos(QString id) const;
 
@@ -134,6 +138,11 @@ private:
     void unloadCentralLayout(CentralLayout *layout);
     void unloadSharedLayout(SharedLayout *layout);
 
+    void discardPrewarmedLayout(CentralLayout *layout);
+    void discardPrewarmedLayouts();
+    //! returns the prewarmed layout and removes it from prewarmed layouts
+    CentralLayout *takePrewarmedLayout(QString layoutName);
+
     bool layoutIsAssigned(QString layoutName);
 
     QString layoutPath(QString layoutName);
@@ -156,6 +165,8 @@ private:
 
     QList<CentralLayout *> m_centralLayouts;
     QList<SharedLayout *> m_sharedLayouts;
+    //! layouts loaded in the background, oldest first
+    QList<CentralLayout *> m_prewarmedLayouts;
 
     Layouts::Manager *m_manager;
     KActivities::Controller *m_activitiesController;
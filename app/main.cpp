@@ -20,7 +20,9 @@
 
 // local
 #include "config-latte.h"
+#include "framebenchmark.h"
 #include "lattecorona.h"
+#include "startuptracer.h"
 #include "layouts/importer.h"
 #include "../liblatte2/types.h"
 
@@ -35,6 +37,7 @@
 #include <QCommandLineParser>
 #include <QCommandLineOption>
 #include <QDir>
+#include <QFileInfo>
 #include <QLockFile>
 #include <QSharedMemory>
 
@@ -59,6 +62,10 @@ inline void detectPlatform(int argc, char **argv);
 
 int main(int argc, char **argv)
 {
+    //! recording is dropped afterwards when --trace-startup is not set
+    Latte::StartupTracer::start();
+    Latte::StartupTracer::begin(QStringLiteral("main: application"));
+
     //Plasma scales itself to font DPI
     //on X, where we don't have compositor scaling, this generally works fine.
     //also there are bugs on older Qt, especially when it comes to fractional scaling
@@ -94,6 +101,9 @@ int main(int argc, char **argv)
 
     configureAboutData();
 
+    Latte::StartupTracer::end(QStringLiteral("main: application"));
+    Latte::StartupTracer::begin(QStringLiteral("main: options parsing"));
+
     QCommandLineParser parser;
     parser.addHelpOption();
     parser.addVersionOption();
@@ -140,10 +150,31 @@ int main(int argc, char **argv)
     overloadedIconsOption.setDescription(QStringLiteral("Show visual indicators for debugging overloaded applets icons (Only useful to devs)."));
     overloadedIconsOption.setFlags(QCommandLineOption::HiddenFromHelp);
     parser.addOption(overloadedIconsOption);
+
+    QCommandLineOption traceStartupOption(QStringList() << QStringLiteral("trace-startup"));
+    traceStartupOption.setDescription(QStringLiteral("Write a trace of the startup phases in Chrome trace-event json format (Only useful to devs)."));
+    traceStartupOption.setValueName(QStringLiteral("file_name"));
+    traceStartupOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(traceStartupOption);
+
+    QCommandLineOption benchmarkFramesOption(QStringList() << QStringLiteral("benchmark-frames"));
+    benchmarkFramesOption.setDescription(QStringLiteral("Run synthetic hover, slide, tasks and location scenarios on the first dock of a temporary layout copy, write its frame timings in json format and exit (Only useful to devs)."));
+    benchmarkFramesOption.setValueName(QStringLiteral("file_name"));
+    benchmarkFramesOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(benchmarkFramesOption);
     //! END: Hidden options
 
     parser.process(app);
 
+    if (parser.isSet(QStringLiteral("trace-startup"))) {
+        Latte::StartupTracer::setOutputFile(QFileInfo(parser.value(QStringLiteral("trace-startup"))).absoluteFilePath());
+        QObject::connect(&app, &QCoreApplication::aboutToQuit, []() {
+            Latte::StartupTracer::finish();
+        });
+    } else {
+        Latte::StartupTracer::stop();
+    }
+
     //! print available-layouts
     if (parser.isSet(QStringLiteral("available-layouts"))) {
         QStringList layouts = Latte::Layouts::Importer::availableLayouts();
@@ -245,6 +276,13 @@ int main(int argc, char **argv)
         memoryUsage = (int)(Latte::Types::SingleLayout);
     }
 
+    //! benchmark option, frames are measured only when they are rendered
+    //! in the gui thread, so the render loop must be set before any view
+    //! is created
+    if (parser.isSet(QStringLiteral("benchmark-frames"))) {
+        qputenv("QSG_RENDER_LOOP", "basic");
+    }
+
     //! debug/mask options
     if (parser.isSet(QStringLiteral("debug")) || parser.isSet(QStringLiteral("mask"))) {
         //! set pattern for debug messages
@@ -274,7 +312,16 @@ int main(int argc, char **argv)
     KCrash::setDrKonqiEnabled(true);
     KCrash::setFlags(KCrash::AutoRestart | KCrash::AlwaysDirectly);
 
+    Latte::StartupTracer::end(QStringLiteral("main: options parsing"));
+
+    Latte::StartupTracer::begin(QStringLiteral("corona: construction"));
     Latte::Corona corona(defaultLayoutOnStartup, layoutNameOnStartup, memoryUsage);
+    Latte::StartupTracer::end(QStringLiteral("corona: construction"));
+
+    if (parser.isSet(QStringLiteral("benchmark-frames"))) {
+        new Latte::FrameBenchmark(&corona, QFileInfo(parser.value(QStringLiteral("benchmark-frames"))).absoluteFilePath());
+    }
+
     KDBusService service(KDBusService::Unique);
 
     return app.exec();
@@ -22,15 +22,22 @@
 
 // local
 #include "lattecorona.h"
+#include "../../startuptracer.h"
 #include "../../layouts/importer.h"
+#include "../../layouts/manager.h"
+#include "../../layouts/persistence.h"
 #include "../../view/panelshadows_p.h"
 #include "../../wm/schemecolors.h"
+#include "../../wm/schemesregistry.h"
 #include "../../../liblatte2/commontools.h"
 
 // Qt
+#include <QDateTime>
 #include <QDebug>
 #include <QDir>
+#include <QFileInfo>
 #include <QProcess>
+#include <QStandardPaths>
 
 // KDE
 #include <KDirWatch>
@@ -43,6 +50,9 @@
 #define DEFAULTCOLORSCHEME "default.colors"
 #define REVERSEDCOLORSCHEME "reversed.colors"
 
+//! increase it when the metrics computations change in order to invalidate old caches
+#define METRICSCACHEVERSION 1
+
 namespace Latte {
 namespace PlasmaExtended {
 
@@ -82,13 +92,16 @@ Theme::Theme(KSharedConfig::Ptr config, QObject *parent) :
 
 void Theme::load()
 {
+    StartupTracer::Span span(QStringLiteral("theme: load"));
+
     loadThemePaths();
     loadRoundness();
 }
 
 Theme::~Theme()
 {
-    saveConfig();
+    m_themeGroup.writeEntry("outlineWidth", m_outlineWidth);
+    m_themeGroup.sync();
 
     m_defaultScheme->deleteLater();
     m_reversedScheme->deleteLater();
@@ -219,6 +232,9 @@ void Theme::updateDefaultScheme()
         m_defaultScheme->deleteLater();
     }
 
+    //! the file was rewritten, its shared colors must be parsed again
+    WindowSystem::SchemesRegistry::self()->reload(m_defaultSchemePath);
+
     m_defaultScheme = new WindowSystem::SchemeColors(this, m_defaultSchemePath, true);
     connect(m_defaultScheme, &WindowSystem::SchemeColors::colorsChanged, this, &Theme::loadThemeLightness);
 
@@ -259,6 +275,8 @@ void Theme::updateReversedScheme()
         m_reversedScheme->deleteLater();
     }
 
+    WindowSystem::SchemesRegistry::self()->reload(m_reversedSchemePath);
+
     m_reversedScheme = new WindowSystem::SchemeColors(this, m_reversedSchemePath, true);
 
     qDebug() << "plasma theme reversed colors ::: " << m_reversedSchemePath;
@@ -378,6 +396,8 @@ int Theme::roundness(const QImage &svgImage, Plasma::Types::Location edge)
 
 void Theme::loadCompositingRoundness()
 {
+    StartupTracer::Span span(QStringLiteral("theme: compute roundness"));
+
     Plasma::FrameSvg *svg = new Plasma::FrameSvg(this);
     svg->setImagePath(QStringLiteral("widgets/panel-background"));
     svg->setEnabledBorders(Plasma::FrameSvg::AllBorders);
@@ -435,12 +455,91 @@ void Theme::loadCompositingRoundness()
 
 void Theme::loadRoundness()
 {
-    loadCompositingRoundness();
+    const QString key = metricsCacheKey();
+
+    if (!loadCachedMetrics(key)) {
+        loadCompositingRoundness();
+        saveCachedMetrics(key);
+    }
 
     emit maxOpacityChanged();
     emit roundnessChanged();
 }
 
+//! metrics depend only on the panel background svg that the theme provides,
+//! so the key changes only when that file is changed or replaced
+QString Theme::metricsCacheKey() const
+{
+    const QString svgPath = m_theme.imagePath(QStringLiteral("widgets/panel-background"));
+    const QFileInfo svgInfo(svgPath);
+
+    if (svgPath.isEmpty() || !svgInfo.exists()) {
+        return QString();
+    }
+
+    return QString::number(METRICSCACHEVERSION) + "|" + svgPath + "|"
+            + QString::number(svgInfo.lastModified().toMSecsSinceEpoch()) + "|" + QString::number(svgInfo.size());
+}
+
+KConfigGroup Theme::metricsCacheGroup() const
+{
+    KSharedConfigPtr cache = KSharedConfig::openConfig(QStringLiteral("lattedock-thememetrics"),
+                                                       KConfig::SimpleConfig,
+                                                       QStandardPaths::GenericCacheLocation);
+
+    return KConfigGroup(cache, m_theme.themeName());
+}
+
+bool Theme::loadCachedMetrics(const QString &key)
+{
+    if (key.isEmpty()) {
+        return false;
+    }
+
+    KConfigGroup metrics = metricsCacheGroup();
+
+    if (metrics.readEntry("key", QString()) != key) {
+        return false;
+    }
+
+    m_bottomEdgeRoundness = metrics.readEntry("bottomEdgeRoundness", 0);
+    m_leftEdgeRoundness = metrics.readEntry("leftEdgeRoundness", 0);
+    m_topEdgeRoundness = metrics.readEntry("topEdgeRoundness", 0);
+    m_rightEdgeRoundness = metrics.readEntry("rightEdgeRoundness", 0);
+
+    m_bottomEdgeMaxOpacity = metrics.readEntry("bottomEdgeMaxOpacity", 1.0f);
+    m_leftEdgeMaxOpacity = metrics.readEntry("leftEdgeMaxOpacity", 1.0f);
+    m_topEdgeMaxOpacity = metrics.readEntry("topEdgeMaxOpacity", 1.0f);
+    m_rightEdgeMaxOpacity = metrics.readEntry("rightEdgeMaxOpacity", 1.0f);
+
+    qDebug() << " CACHED ROUNDNESS ::: " << m_bottomEdgeRoundness << " _ " << m_leftEdgeRoundness << " _ " << m_topEdgeRoundness << " _ " << m_rightEdgeRoundness;
+
+    return true;
+}
+
+void Theme::saveCachedMetrics(const QString &key)
+{
+    if (key.isEmpty()) {
+        return;
+    }
+
+    KConfigGroup metrics = metricsCacheGroup();
+
+    metrics.writeEntry("key", key);
+
+    metrics.writeEntry("bottomEdgeRoundness", m_bottomEdgeRoundness);
+    metrics.writeEntry("leftEdgeRoundness", m_leftEdgeRoundness);
+    metrics.writeEntry("topEdgeRoundness", m_topEdgeRoundness);
+    metrics.writeEntry("rightEdgeRoundness", m_rightEdgeRoundness);
+
+    metrics.writeEntry("bottomEdgeMaxOpacity", m_bottomEdgeMaxOpacity);
+    metrics.writeEntry("leftEdgeMaxOpacity", m_leftEdgeMaxOpacity);
+    metrics.writeEntry("topEdgeMaxOpacity", m_topEdgeMaxOpacity);
+    metrics.writeEntry("rightEdgeMaxOpacity", m_rightEdgeMaxOpacity);
+
+    metrics.sync();
+}
+
 void Theme::loadThemePaths()
 {
     m_themePath = Layouts::Importer::standardPath("plasma/desktoptheme/" + m_theme.themeName());
@@ -625,7 +724,11 @@ void Theme::saveConfig()
 {
     m_themeGroup.writeEntry("outlineWidth", m_outlineWidth);
 
-    m_themeGroup.sync();
+    if (m_corona && m_corona->layoutsManager()) {
+        m_corona->layoutsManager()->persistence()->markDirty(m_themeGroup);
+    } else {
+        m_themeGroup.sync();
+    }
 }
 
 }
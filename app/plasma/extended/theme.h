@@ -114,6 +114,12 @@ private:
     void loadRoundness();
     void loadCompositingRoundness();
 
+    //! roundness and opacity metrics are cached on disk per plasma theme
+    bool loadCachedMetrics(const QString &key);
+    void saveCachedMetrics(const QString &key);
+    QString metricsCacheKey() const;
+    KConfigGroup metricsCacheGroup() const;
+
     void setOriginalSchemeFile(const QString &file);
     void parseThemeSvgFiles();
     void updateDefaultScheme();
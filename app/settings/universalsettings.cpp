@@ -23,6 +23,7 @@
 // local
 #include "../layouts/importer.h"
 #include "../layouts/manager.h"
+#include "../layouts/persistence.h"
 
 // Qt
 #include <QDebug>
@@ -57,12 +58,16 @@ UniversalSettings::UniversalSettings(KSharedConfig::Ptr config, QObject *parent)
     connect(this, &UniversalSettings::launchersChanged, this, &UniversalSettings::saveConfig);
     connect(this, &UniversalSettings::layoutsColumnWidthsChanged, this, &UniversalSettings::saveConfig);
     connect(this, &UniversalSettings::layoutsMemoryUsageChanged, this, &UniversalSettings::saveConfig);
+    connect(this, &UniversalSettings::maxPrewarmedLayoutsChanged, this, &UniversalSettings::saveConfig);
     connect(this, &UniversalSettings::layoutsWindowSizeChanged, this, &UniversalSettings::saveConfig);
     connect(this, &UniversalSettings::metaPressAndHoldEnabledChanged, this, &UniversalSettings::saveConfig);
     connect(this, &UniversalSettings::mouseSensitivityChanged, this, &UniversalSettings::saveConfig);
+    connect(this, &UniversalSettings::persistentAppDataCacheChanged, this, &UniversalSettings::saveConfig);
     connect(this, &UniversalSettings::screenTrackerIntervalChanged, this, &UniversalSettings::saveConfig);
     connect(this, &UniversalSettings::showInfoWindowChanged, this, &UniversalSettings::saveConfig);
+    connect(this, &UniversalSettings::syncIntervalChanged, this, &UniversalSettings::saveConfig);
     connect(this, &UniversalSettings::versionChanged, this, &UniversalSettings::saveConfig);
+    connect(this, &UniversalSettings::windowChangesIntervalChanged, this, &UniversalSettings::saveConfig);
 
     connect(this, &UniversalSettings::screenScalesChanged, this, &UniversalSettings::saveScalesConfig);
 
@@ -72,7 +77,11 @@ UniversalSettings::UniversalSettings(KSharedConfig::Ptr config, QObject *parent)
 
 UniversalSettings::~UniversalSettings()
 {
-    saveConfig();
+    //! on destruction the layouts manager may have been already removed,
+    //! so the configuration is written directly
+    writeConfig();
+    m_universalGroup.sync();
+
     cleanupSettings();
 }
 
@@ -158,6 +167,66 @@ void UniversalSettings::setScreenTrackerInterval(int duration)
     emit screenTrackerIntervalChanged();
 }
 
+int UniversalSettings::syncInterval() const
+{
+    return m_syncInterval;
+}
+
+void UniversalSettings::setSyncInterval(int duration)
+{
+    if (m_syncInterval == duration) {
+        return;
+    }
+
+    m_syncInterval = duration;
+    emit syncIntervalChanged();
+}
+
+int UniversalSettings::windowChangesInterval() const
+{
+    return m_windowChangesInterval;
+}
+
+void UniversalSettings::setWindowChangesInterval(int duration)
+{
+    if (m_windowChangesInterval == duration) {
+        return;
+    }
+
+    m_windowChangesInterval = duration;
+    emit windowChangesIntervalChanged();
+}
+
+bool UniversalSettings::persistentAppDataCache() const
+{
+    return m_persistentAppDataCache;
+}
+
+void UniversalSettings::setPersistentAppDataCache(bool persistent)
+{
+    if (m_persistentAppDataCache == persistent) {
+        return;
+    }
+
+    m_persistentAppDataCache = persistent;
+    emit persistentAppDataCacheChanged();
+}
+
+int UniversalSettings::maxPrewarmedLayouts() const
+{
+    return m_maxPrewarmedLayouts;
+}
+
+void UniversalSettings::setMaxPrewarmedLayouts(int count)
+{
+    if (m_maxPrewarmedLayouts == count) {
+        return;
+    }
+
+    m_maxPrewarmedLayouts = count;
+    emit maxPrewarmedLayoutsChanged();
+}
+
 QString UniversalSettings::currentLayoutName() const
 {
     return m_currentLayoutName;
@@ -530,9 +599,13 @@ void UniversalSettings::loadConfig()
     m_layoutsWindowSize = m_universalGroup.readEntry("layoutsWindowSize", QSize(700, 450));
     m_layoutsColumnWidths = m_universalGroup.readEntry("layoutsColumnWidths", QStringList());
     m_launchers = m_universalGroup.readEntry("launchers", QStringList());
+    m_maxPrewarmedLayouts = m_universalGroup.readEntry("maxPrewarmedLayouts", 2);
     m_metaPressAndHoldEnabled = m_universalGroup.readEntry("metaPressAndHoldEnabled", true);
+    m_persistentAppDataCache = m_universalGroup.readEntry("persistentAppDataCache", false);
     m_screenTrackerInterval = m_universalGroup.readEntry("screenTrackerInterval", 2500);
     m_showInfoWindow = m_universalGroup.readEntry("showInfoWindow", true);
+    m_syncInterval = m_universalGroup.readEntry("syncInterval", 1000);
+    m_windowChangesInterval = m_universalGroup.readEntry("windowChangesInterval", 150);
     m_memoryUsage = static_cast<Types::LayoutsMemoryUsage>(m_universalGroup.readEntry("memoryUsage", (int)Types::SingleLayout));
     m_mouseSensitivity = static_cast<Types::MouseSensitivity>(m_universalGroup.readEntry("mouseSensitivity", (int)Types::HighSensitivity));
 
@@ -540,6 +613,12 @@ void UniversalSettings::loadConfig()
 }
 
 void UniversalSettings::saveConfig()
+{
+    writeConfig();
+    requestConfigSync(m_universalGroup);
+}
+
+void UniversalSettings::writeConfig()
 {
     m_universalGroup.writeEntry("version", m_version);
     m_universalGroup.writeEntry("badges3DStyle", m_badges3DStyle);
@@ -550,13 +629,24 @@ void UniversalSettings::saveConfig()
     m_universalGroup.writeEntry("layoutsWindowSize", m_layoutsWindowSize);
     m_universalGroup.writeEntry("layoutsColumnWidths", m_layoutsColumnWidths);
     m_universalGroup.writeEntry("launchers", m_launchers);
+    m_universalGroup.writeEntry("maxPrewarmedLayouts", m_maxPrewarmedLayouts);
     m_universalGroup.writeEntry("metaPressAndHoldEnabled", m_metaPressAndHoldEnabled);
+    m_universalGroup.writeEntry("persistentAppDataCache", m_persistentAppDataCache);
     m_universalGroup.writeEntry("screenTrackerInterval", m_screenTrackerInterval);
     m_universalGroup.writeEntry("showInfoWindow", m_showInfoWindow);
+    m_universalGroup.writeEntry("syncInterval", m_syncInterval);
+    m_universalGroup.writeEntry("windowChangesInterval", m_windowChangesInterval);
     m_universalGroup.writeEntry("memoryUsage", (int)m_memoryUsage);
     m_universalGroup.writeEntry("mouseSensitivity", (int)m_mouseSensitivity);
+}
 
-    m_universalGroup.sync();
+void UniversalSettings::requestConfigSync(const KConfigGroup &group)
+{
+    if (m_corona && m_corona->layoutsManager()) {
+        m_corona->layoutsManager()->persistence()->markDirty(group);
+    } else {
+        KConfigGroup(group).sync();
+    }
 }
 
 void UniversalSettings::cleanupSettings()
@@ -613,7 +703,7 @@ void UniversalSettings::saveScalesConfig()
         m_screenScalesGroup.writeEntry(screenName, scales.join(";"));
     }
 
-    m_screenScalesGroup.sync();
+    requestConfigSync(m_screenScalesGroup);
 }
 
 }
@@ -101,6 +101,25 @@ public:
     int screenTrackerInterval() const;
     void setScreenTrackerInterval(int duration);
 
+    //! the time window in ms that configuration writes are coalesced before
+    //! they are saved to disk
+    int syncInterval() const;
+    void setSyncInterval(int duration);
+
+    //! the time window in ms that windows changes from the window manager
+    //! are batched before the windows tracker is informed
+    int windowChangesInterval() const;
+    void setWindowChangesInterval(int duration);
+
+    //! the applications identification cache is stored in order to be reused after restarts
+    bool persistentAppDataCache() const;
+    void setPersistentAppDataCache(bool persistent);
+
+    //! how many layouts can be loaded in the background at the same time
+    //! in order to be shown instantly when the user switches to them
+    int maxPrewarmedLayouts() const;
+    void setMaxPrewarmedLayouts(int count);
+
     QString currentLayoutName() const;
     void setCurrentLayoutName(QString layoutName);
 
@@ -146,13 +165,17 @@ signals:
     void layoutsWindowSizeChanged();
     void launchersChanged();
     void layoutsMemoryUsageChanged();
+    void maxPrewarmedLayoutsChanged();
     void metaPressAndHoldEnabledChanged();
     void mouseSensitivityChanged();
+    void persistentAppDataCacheChanged();
     void screensCountChanged();
     void screenScalesChanged();
     void screenTrackerIntervalChanged();
     void showInfoWindowChanged();
+    void syncIntervalChanged();
     void versionChanged();
+    void windowChangesIntervalChanged();
 
 private slots:
     void loadConfig();
@@ -166,6 +189,8 @@ private slots:
 
 private:
     void cleanupSettings();
+    void writeConfig();
+    void requestConfigSync(const KConfigGroup &group);
 
     void setColorsScriptIsPresent(bool present);
 
@@ -177,6 +202,7 @@ private:
     bool m_canDisableBorders{false};
     bool m_colorsScriptIsPresent{false};
     bool m_metaPressAndHoldEnabled{true};
+    bool m_persistentAppDataCache{false};
     bool m_showInfoWindow{true};
 
     //!kwinrc tracking
@@ -187,6 +213,9 @@ private:
     int m_version{1};
 
     int m_screenTrackerInterval{2500};
+    int m_syncInterval{1000};
+    int m_windowChangesInterval{150};
+    int m_maxPrewarmedLayouts{2};
 
     QString m_currentLayoutName;
     QString m_lastNonAssignedLayoutName;
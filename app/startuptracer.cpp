@@ -0,0 +1,200 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "startuptracer.h"
+
+// Qt
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QThread>
+#include <QTimer>
+
+namespace Latte {
+
+namespace {
+//! time given to the rest of the views to render after the first rendered frame
+const int FINISHDELAY = 2000;
+
+bool s_enabled{false};
+bool s_finishScheduled{false};
+QString s_file;
+QElapsedTimer s_clock;
+QHash<QString, qint64> s_openSpans;
+QHash<quintptr, int> s_threadIds;
+QJsonArray s_events;
+
+qint64 timestamp()
+{
+    return s_clock.nsecsElapsed() / 1000;
+}
+
+//! trace viewers expect numeric thread ids, native thread handles may not
+//! fit in a json number so threads are numbered in order of appearance
+int threadId()
+{
+    const quintptr handle = reinterpret_cast<quintptr>(QThread::currentThreadId());
+
+    if (!s_threadIds.contains(handle)) {
+        s_threadIds[handle] = s_threadIds.count() + 1;
+    }
+
+    return s_threadIds[handle];
+}
+
+QJsonObject event(const QString &name, const QString &phase, qint64 ts)
+{
+    QJsonObject ev;
+    ev["name"] = name;
+    ev["cat"] = QStringLiteral("startup");
+    ev["ph"] = phase;
+    ev["ts"] = ts;
+    ev["pid"] = QCoreApplication::applicationPid();
+    ev["tid"] = threadId();
+    return ev;
+}
+}
+
+void StartupTracer::start()
+{
+    if (s_enabled) {
+        return;
+    }
+
+    s_enabled = true;
+    s_clock.start();
+}
+
+void StartupTracer::stop()
+{
+    s_enabled = false;
+    s_openSpans.clear();
+    s_events = QJsonArray();
+}
+
+void StartupTracer::setOutputFile(const QString &file)
+{
+    s_file = file;
+
+    qDebug() << "startup tracer :: recording startup trace to:" << file;
+}
+
+bool StartupTracer::isEnabled()
+{
+    return s_enabled;
+}
+
+void StartupTracer::begin(const QString &name)
+{
+    if (!s_enabled) {
+        return;
+    }
+
+    s_openSpans[name] = timestamp();
+}
+
+void StartupTracer::end(const QString &name)
+{
+    if (!s_enabled || !s_openSpans.contains(name)) {
+        return;
+    }
+
+    const qint64 startTs = s_openSpans.take(name);
+
+    //! complete events are used because spans may end in a different scope
+    QJsonObject ev = event(name, QStringLiteral("X"), startTs);
+    ev["dur"] = timestamp() - startTs;
+    s_events.append(ev);
+}
+
+void StartupTracer::instant(const QString &name)
+{
+    if (!s_enabled) {
+        return;
+    }
+
+    QJsonObject ev = event(name, QStringLiteral("i"), timestamp());
+    ev["s"] = QStringLiteral("p");
+    s_events.append(ev);
+}
+
+void StartupTracer::firstFrameRendered()
+{
+    if (!s_enabled || s_finishScheduled) {
+        return;
+    }
+
+    s_finishScheduled = true;
+    instant(QStringLiteral("first view frame"));
+
+    QTimer::singleShot(FINISHDELAY, []() {
+        StartupTracer::finish();
+    });
+}
+
+void StartupTracer::finish()
+{
+    if (!s_enabled || s_file.isEmpty()) {
+        return;
+    }
+
+    //! spans that never ended are closed at the time of writing
+    for (const auto &name : s_openSpans.keys()) {
+        end(name);
+    }
+
+    s_enabled = false;
+
+    QJsonObject trace;
+    trace["traceEvents"] = s_events;
+    trace["displayTimeUnit"] = QStringLiteral("ms");
+
+    QSaveFile file(s_file);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "startup tracer :: trace file could not be written:" << s_file;
+        return;
+    }
+
+    file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+
+    if (file.commit()) {
+        qDebug() << "startup tracer :: trace with" << s_events.count() << "events written to:" << s_file;
+    }
+
+    s_events = QJsonArray();
+}
+
+StartupTracer::Span::Span(const QString &name)
+    : m_name(name)
+{
+    StartupTracer::begin(m_name);
+}
+
+StartupTracer::Span::~Span()
+{
+    StartupTracer::end(m_name);
+}
+
+}
@@ -0,0 +1,69 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef STARTUPTRACER_H
+#define STARTUPTRACER_H
+
+// Qt
+#include <QString>
+
+namespace Latte {
+
+//! StartupTracer records the time spent in the startup phases of Latte
+//! and writes them as a Chrome trace-event json file, that can be opened
+//! with chrome://tracing or Perfetto. Recording starts at the very beginning
+//! of main() and it is kept only when the --trace-startup command line option
+//! is set, otherwise it is stopped and all of its calls return immediately.
+class StartupTracer
+{
+public:
+    //! starts recording, the trace is written only when an output file is set
+    static void start();
+    //! stops recording and drops all the recorded spans
+    static void stop();
+    static void setOutputFile(const QString &file);
+
+    static bool isEnabled();
+
+    //! spans are identified by their name and may begin and end in different scopes
+    static void begin(const QString &name);
+    static void end(const QString &name);
+    static void instant(const QString &name);
+
+    //! the first frame of a view was rendered, the trace is written after a while
+    //! in order for the rest of the views to be included
+    static void firstFrameRendered();
+    //! writes the trace file and stops recording
+    static void finish();
+
+    //! records a span for the lifetime of its scope
+    class Span
+    {
+    public:
+        Span(const QString &name);
+        ~Span();
+
+    private:
+        QString m_name;
+    };
+};
+
+}
+
+#endif
@@ -0,0 +1,336 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "statusservice.h"
+
+// local
+#include "lattecorona.h"
+#include "statusadaptor.h"
+#include "layout/centrallayout.h"
+#include "layout/genericlayout.h"
+#include "layout/sharedlayout.h"
+#include "layouts/manager.h"
+#include "layouts/synchronizer.h"
+#include "view/effects.h"
+#include "view/positioner.h"
+#include "view/view.h"
+#include "view/visibilitymanager.h"
+#include "wm/abstractwindowinterface.h"
+#include "wm/appdatacache.h"
+#include "wm/windowsindex.h"
+#include "wm/tracker/windowstracker.h"
+
+// Qt
+#include <QDBusConnection>
+
+// Plasma
+#include <Plasma/Containment>
+
+namespace Latte {
+
+namespace {
+const int CHANGEDINTERVAL = 250;
+
+const QString STATUSSECTION = QStringLiteral("status");
+const QString LAYOUTSSECTION = QStringLiteral("layouts");
+const QString VIEWSSECTION = QStringLiteral("views");
+const QString TRACKERSECTION = QStringLiteral("tracker");
+}
+
+StatusService::StatusService(Latte::Corona *corona)
+    : QObject(corona),
+      m_corona(corona)
+{
+    //! changes are announced at most once per interval
+    m_changedTimer.setInterval(CHANGEDINTERVAL);
+    m_changedTimer.setSingleShot(true);
+    connect(&m_changedTimer, &QTimer::timeout, this, &StatusService::emitChanged);
+
+    Layouts::Manager *manager = m_corona->layoutsManager();
+
+    connect(manager, &Layouts::Manager::currentLayoutNameChanged, this, [&]() {
+        markChanged(STATUSSECTION);
+    });
+    connect(manager, &Layouts::Manager::menuLayoutsChanged, this, [&]() {
+        markChanged(STATUSSECTION);
+    });
+    connect(manager, &Layouts::Manager::layoutsChanged, this, [&]() {
+        markChanged(LAYOUTSSECTION);
+    });
+    connect(manager, &Layouts::Manager::centralLayoutsChanged, this, &StatusService::trackLayouts);
+    connect(manager, &Layouts::Manager::currentLayoutChanged, this, &StatusService::trackLayouts);
+
+    connect(m_corona->wm()->windowsTracker(), &WindowSystem::Tracker::Windows::snapshotPublished, this, [&]() {
+        markChanged(TRACKERSECTION);
+    });
+
+    trackLayouts();
+
+    new StatusAdaptor(this);
+    QDBusConnection::sessionBus().registerObject(QStringLiteral("/Latte/Status"), this);
+}
+
+StatusService::~StatusService()
+{
+}
+
+void StatusService::markChanged(const QString &section)
+{
+    if (!m_changedSections.contains(section)) {
+        m_changedSections << section;
+    }
+
+    if (!m_changedTimer.isActive()) {
+        m_changedTimer.start();
+    }
+}
+
+void StatusService::emitChanged()
+{
+    if (m_changedSections.isEmpty()) {
+        return;
+    }
+
+    const QStringList sections = m_changedSections;
+    m_changedSections.clear();
+
+    emit changed(sections);
+}
+
+void StatusService::trackLayouts()
+{
+    for (auto layout : activeLayouts()) {
+        if (m_trackedLayouts.contains(layout)) {
+            continue;
+        }
+
+        m_trackedLayouts << layout;
+        connect(layout, &Layout::GenericLayout::viewsCountChanged, this, &StatusService::trackViews);
+    }
+
+    m_trackedLayouts.removeAll(nullptr);
+
+    markChanged(STATUSSECTION);
+    markChanged(LAYOUTSSECTION);
+    trackViews();
+}
+
+void StatusService::trackViews()
+{
+    auto viewChanged = [this]() {
+        markChanged(VIEWSSECTION);
+    };
+
+    for (auto view : activeViews()) {
+        if (!m_trackedViews.contains(view)) {
+            m_trackedViews << view;
+
+            connect(view, &Latte::View::typeChanged, this, viewChanged);
+            connect(view, &Latte::View::absoluteGeometryChanged, this, viewChanged);
+            connect(view, &QObject::destroyed, this, viewChanged);
+            connect(view->positioner(), &ViewPart::Positioner::currentScreenChanged, this, viewChanged);
+
+            //! pooled views recreate their visibility manager when they are reused
+            connect(view, &Latte::View::visibilityChanged, this, &StatusService::trackViews);
+        }
+
+        //! visibility managers are tracked on their own because they
+        //! are recreated for views that are reused
+        ViewPart::VisibilityManager *visibility = view->visibility();
+
+        if (visibility && !m_trackedVisibilities.contains(visibility)) {
+            m_trackedVisibilities << visibility;
+
+            connect(visibility, &ViewPart::VisibilityManager::modeChanged, this, viewChanged);
+            connect(visibility, &ViewPart::VisibilityManager::isHiddenChanged, this, viewChanged);
+            connect(visibility, &ViewPart::VisibilityManager::containsMouseChanged, this, viewChanged);
+            connect(visibility, &ViewPart::VisibilityManager::blockHidingChanged, this, viewChanged);
+        }
+    }
+
+    m_trackedViews.removeAll(nullptr);
+    m_trackedVisibilities.removeAll(nullptr);
+
+    markChanged(VIEWSSECTION);
+}
+
+QList<Layout::GenericLayout *> StatusService::activeLayouts() const
+{
+    QList<Layout::GenericLayout *> layouts;
+    Layouts::Synchronizer *synchronizer = m_corona->layoutsManager()->synchronizer();
+
+    for (const auto &name : synchronizer->centralLayoutsNames()) {
+        if (auto layout = synchronizer->centralLayout(name)) {
+            layouts << layout;
+        }
+    }
+
+    for (const auto &name : synchronizer->sharedLayoutsNames()) {
+        if (auto layout = synchronizer->sharedLayout(name)) {
+            layouts << layout;
+        }
+    }
+
+    return layouts;
+}
+
+QList<Latte::View *> StatusService::activeViews() const
+{
+    QList<Latte::View *> views;
+
+    for (auto layout : activeLayouts()) {
+        for (auto view : layout->latteViews()) {
+            if (view && view->containment() && !views.contains(view)) {
+                views << view;
+            }
+        }
+    }
+
+    return views;
+}
+
+QVariantMap StatusService::status() const
+{
+    Layouts::Manager *manager = m_corona->layoutsManager();
+
+    QVariantMap data;
+    data["memoryUsage"] = (int)manager->memoryUsage();
+    data["currentLayout"] = manager->currentLayoutName();
+    data["menuLayouts"] = manager->menuLayouts();
+    data["activeLayouts"] = manager->synchronizer()->centralLayoutsNames();
+    data["sharedLayouts"] = manager->synchronizer()->sharedLayoutsNames();
+    data["viewsCount"] = activeViews().count();
+
+    return data;
+}
+
+QVariantMap StatusService::layouts() const
+{
+    Layouts::Synchronizer *synchronizer = m_corona->layoutsManager()->synchronizer();
+
+    QVariantMap data;
+
+    for (const auto &name : m_corona->layoutsManager()->layouts()) {
+        QVariantMap layoutData;
+        CentralLayout *central = synchronizer->centralLayout(name);
+        SharedLayout *shared = synchronizer->sharedLayout(name);
+
+        layoutData["active"] = (central != nullptr || shared != nullptr);
+        layoutData["shared"] = (shared != nullptr);
+        layoutData["current"] = (name == m_corona->layoutsManager()->currentLayoutName());
+
+        if (central) {
+            layoutData["activities"] = central->activities();
+            layoutData["viewsCount"] = central->viewsCount();
+        } else if (shared) {
+            layoutData["viewsCount"] = shared->viewsCount();
+        }
+
+        data[name] = layoutData;
+    }
+
+    return data;
+}
+
+QVariantMap StatusService::viewData(Latte::View *view) const
+{
+    QVariantMap data;
+
+    data["id"] = view->containment()->id();
+    data["layout"] = view->layout() ? view->layout()->name() : QString();
+    data["type"] = (int)view->type();
+    data["location"] = (int)view->location();
+    data["screen"] = view->positioner()->currentScreenName();
+    data["onPrimary"] = view->onPrimary();
+    data["geometry"] = view->absoluteGeometry();
+
+    if (view->visibility()) {
+        data["visibilityMode"] = (int)view->visibility()->mode();
+        data["isHidden"] = view->visibility()->isHidden();
+        data["containsMouse"] = view->visibility()->containsMouse();
+        data["blockHiding"] = view->visibility()->blockHiding();
+        data["visibilityStatistics"] = view->visibility()->stateStatistics();
+    }
+
+    data["compositorPushesSent"] = view->effects()->compositorPushesSent();
+    data["compositorPushesSkipped"] = view->effects()->compositorPushesSkipped();
+
+    return data;
+}
+
+QVariantMap StatusService::views() const
+{
+    QVariantMap data;
+
+    for (auto view : activeViews()) {
+        data[QString::number(view->containment()->id())] = viewData(view);
+    }
+
+    return data;
+}
+
+QVariantMap StatusService::view(uint id) const
+{
+    for (auto view : activeViews()) {
+        if (view->containment()->id() == id) {
+            return viewData(view);
+        }
+    }
+
+    return QVariantMap();
+}
+
+QVariantMap StatusService::trackerStatistics() const
+{
+    WindowSystem::AbstractWindowInterface *wm = m_corona->wm();
+    const WindowSystem::Tracker::WindowsSnapshotPtr snapshot = wm->windowsTracker()->snapshot();
+
+    QVariantMap data;
+    data["trackedWindows"] = snapshot->windows.count();
+    data["snapshotVersion"] = (qulonglong)snapshot->version;
+    data["windowChangesReceived"] = wm->windowChangesReceived();
+    data["windowChangesFlushes"] = wm->windowChangesFlushes();
+    data["windowChangesInterval"] = wm->windowChangesInterval();
+    data["appDataCacheHits"] = wm->appDataCache()->hits();
+    data["appDataCacheMisses"] = wm->appDataCache()->misses();
+    data["windowsIndexLookups"] = (qulonglong)WindowSystem::WindowsIndexMetrics::lookups();
+
+    return data;
+}
+
+QVariantMap StatusService::query(const QStringList &sections) const
+{
+    QVariantMap data;
+
+    for (const auto &section : sections) {
+        if (section == STATUSSECTION) {
+            data[section] = status();
+        } else if (section == LAYOUTSSECTION) {
+            data[section] = layouts();
+        } else if (section == VIEWSSECTION) {
+            data[section] = views();
+        } else if (section == TRACKERSECTION) {
+            data[section] = trackerStatistics();
+        }
+    }
+
+    return data;
+}
+
+}
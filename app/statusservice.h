@@ -0,0 +1,96 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef STATUSSERVICE_H
+#define STATUSSERVICE_H
+
+// Qt
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <QTimer>
+#include <QVariantMap>
+
+namespace Latte {
+class Corona;
+class View;
+namespace Layout {
+class GenericLayout;
+}
+namespace ViewPart {
+class VisibilityManager;
+}
+}
+
+namespace Latte {
+
+//! Read-only D-Bus status service at /Latte/Status. Every answer is an a{sv}
+//! map with typed values. query() answers many sections with one call. The
+//! changed signal is coalesced, so monitoring tools learn which sections to
+//! query again without polling all of them.
+class StatusService : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.kde.LatteDock.Status")
+
+public:
+    StatusService(Latte::Corona *corona);
+    ~StatusService() override;
+
+public slots:
+    Q_SCRIPTABLE QVariantMap status() const;
+    Q_SCRIPTABLE QVariantMap layouts() const;
+    Q_SCRIPTABLE QVariantMap views() const;
+    Q_SCRIPTABLE QVariantMap view(uint id) const;
+    Q_SCRIPTABLE QVariantMap trackerStatistics() const;
+
+    //! batched query, sections can be: status, layouts, views and tracker
+    Q_SCRIPTABLE QVariantMap query(const QStringList &sections) const;
+
+signals:
+    Q_SCRIPTABLE void changed(const QStringList &sections);
+
+private slots:
+    void trackLayouts();
+    void trackViews();
+    void emitChanged();
+
+private:
+    void markChanged(const QString &section);
+
+    QList<Layout::GenericLayout *> activeLayouts() const;
+    QList<Latte::View *> activeViews() const;
+
+    QVariantMap viewData(Latte::View *view) const;
+
+private:
+    QStringList m_changedSections;
+    QTimer m_changedTimer;
+
+    QList<QPointer<Layout::GenericLayout>> m_trackedLayouts;
+    QList<QPointer<Latte::View>> m_trackedViews;
+    QList<QPointer<ViewPart::VisibilityManager>> m_trackedVisibilities;
+
+    Latte::Corona *m_corona{nullptr};
+};
+
+}
+
+#endif
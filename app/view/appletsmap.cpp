@@ -0,0 +1,304 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "appletsmap.h"
+
+// local
+#include "view.h"
+
+// C++
+#include <algorithm>
+
+// KDE
+#include <KConfigGroup>
+#include <KPluginMetaData>
+
+// Plasma
+#include <Plasma/Applet>
+#include <Plasma/Containment>
+#include <Plasma/Corona>
+#include <PlasmaQuick/AppletQuickItem>
+
+namespace Latte {
+namespace ViewPart {
+
+AppletsMap::AppletsMap(Latte::View *view)
+    : QObject(view),
+      m_latteView(view)
+{
+}
+
+AppletsMap::~AppletsMap()
+{
+}
+
+void AppletsMap::reset()
+{
+    for (auto item : m_trackedItems) {
+        disconnect(item, nullptr, this, nullptr);
+    }
+
+    m_trackedItems.clear();
+    m_entries.clear();
+
+    setContainment(nullptr);
+}
+
+void AppletsMap::invalidate()
+{
+    m_entriesDirty = true;
+    m_rectsDirty = true;
+}
+
+void AppletsMap::geometryChanged()
+{
+    m_rectsDirty = true;
+}
+
+bool AppletsMap::isVertical() const
+{
+    return m_latteView->formFactor() == Plasma::Types::Vertical;
+}
+
+void AppletsMap::setContainment(Plasma::Containment *containment)
+{
+    if (m_containment == containment) {
+        return;
+    }
+
+    if (m_containment) {
+        disconnect(m_containment, nullptr, this, nullptr);
+    }
+
+    m_containment = containment;
+
+    if (m_containment) {
+        connect(m_containment, &Plasma::Containment::appletAdded, this, &AppletsMap::invalidate);
+        connect(m_containment, &Plasma::Containment::appletRemoved, this, &AppletsMap::invalidate);
+        connect(m_containment, &Plasma::Containment::formFactorChanged, this, &AppletsMap::geometryChanged);
+    }
+
+    invalidate();
+}
+
+void AppletsMap::parentChanged()
+{
+    m_rectsDirty = true;
+    updateTracking();
+}
+
+void AppletsMap::updateTracking()
+{
+    //! the applet items and all their parents up to the view contentItem are tracked
+    //! because layouts are moving their applets also, when an item is reparented the
+    //! chains are walked again and the parents that left them are not tracked any more
+    QSet<QQuickItem *> chains;
+
+    for (const auto &entry : m_entries) {
+        for (QQuickItem *item = entry.item; item && !chains.contains(item); item = item->parentItem()) {
+            chains << item;
+
+            if (item == m_latteView->contentItem()) {
+                break;
+            }
+        }
+    }
+
+    for (auto item : m_trackedItems) {
+        if (!chains.contains(item)) {
+            disconnect(item, nullptr, this, nullptr);
+        }
+    }
+
+    for (auto item : chains) {
+        if (m_trackedItems.contains(item)) {
+            continue;
+        }
+
+        connect(item, &QQuickItem::xChanged, this, &AppletsMap::geometryChanged);
+        connect(item, &QQuickItem::yChanged, this, &AppletsMap::geometryChanged);
+        connect(item, &QQuickItem::widthChanged, this, &AppletsMap::geometryChanged);
+        connect(item, &QQuickItem::heightChanged, this, &AppletsMap::geometryChanged);
+        connect(item, &QQuickItem::visibleChanged, this, &AppletsMap::geometryChanged);
+        connect(item, &QQuickItem::parentChanged, this, &AppletsMap::parentChanged);
+        connect(item, &QObject::destroyed, this, [this, item]() {
+            m_trackedItems.remove(item);
+            invalidate();
+        });
+    }
+
+    m_trackedItems = chains;
+}
+
+QQuickItem *AppletsMap::appletItemFor(Plasma::Applet *applet) const
+{
+    PlasmaQuick::AppletQuickItem *ai = applet->property("_plasma_graphicObject").value<PlasmaQuick::AppletQuickItem *>();
+
+    if (!ai) {
+        return nullptr;
+    }
+
+    //! the containment AppletItem that holds the applet is used because it
+    //! describes the visual appearance of the applet including its spacers
+    for (QQuickItem *item = ai->parentItem(); item && item != m_latteView->contentItem(); item = item->parentItem()) {
+        if (item->property("applet").value<QQuickItem *>() == ai) {
+            return item;
+        }
+    }
+
+    return ai;
+}
+
+Plasma::Containment *AppletsMap::systrayFor(Plasma::Applet *applet) const
+{
+    const QString pluginId = applet->kPackage().metadata().pluginId();
+
+    if (pluginId != QLatin1String("org.kde.plasma.systemtray") && pluginId != QLatin1String("org.nomad.systemtray")) {
+        return nullptr;
+    }
+
+    const uint systrayId = applet->config().readEntry("SystrayContainmentId", 0);
+
+    for (const auto containment : m_latteView->corona()->containments()) {
+        if (containment->id() == systrayId) {
+            return containment;
+        }
+    }
+
+    return nullptr;
+}
+
+void AppletsMap::updateEntries()
+{
+    m_entries.clear();
+    m_entriesDirty = false;
+
+    for (Plasma::Applet *applet : m_containment->applets()) {
+        QQuickItem *item = appletItemFor(applet);
+
+        if (!item) {
+            //! the applet is not loaded yet, it is retried on the next request
+            m_entriesDirty = true;
+            continue;
+        }
+
+        Entry entry;
+        entry.applet = applet;
+        entry.item = item;
+        entry.systray = systrayFor(applet);
+
+        m_entries << entry;
+    }
+
+    updateTracking();
+    m_rectsDirty = true;
+}
+
+void AppletsMap::updateRects()
+{
+    QQuickItem *contentItem = m_latteView->contentItem();
+
+    for (auto &entry : m_entries) {
+        if (entry.item && entry.item->isVisible() && entry.applet) {
+            entry.rect = entry.item->mapRectToItem(contentItem, QRectF(0, 0, entry.item->width(), entry.item->height()));
+        } else {
+            entry.rect = QRectF();
+        }
+    }
+
+    const bool vertical = isVertical();
+
+    std::sort(m_entries.begin(), m_entries.end(), [vertical](const Entry &a, const Entry &b) {
+        return vertical ? a.rect.top() < b.rect.top() : a.rect.left() < b.rect.left();
+    });
+
+    m_rectsDirty = false;
+}
+
+Plasma::Applet *AppletsMap::systrayAppletAt(Plasma::Containment *systray, const QPointF &pos) const
+{
+    //! systray applets are only a few and are checked only when their systray is found under pos
+    for (const Plasma::Applet *applet : systray->applets()) {
+        PlasmaQuick::AppletQuickItem *ai = applet->property("_plasma_graphicObject").value<PlasmaQuick::AppletQuickItem *>();
+
+        if (ai && ai->isVisible() && ai->contains(ai->mapFromItem(m_latteView->contentItem(), pos))) {
+            return ai->applet();
+        }
+    }
+
+    return nullptr;
+}
+
+Plasma::Applet *AppletsMap::appletAt(const QPointF &pos, bool *inSystray)
+{
+    if (inSystray) {
+        *inSystray = false;
+    }
+
+    setContainment(m_latteView->containment());
+
+    if (!m_containment) {
+        return nullptr;
+    }
+
+    if (m_entriesDirty) {
+        updateEntries();
+    }
+
+    if (m_rectsDirty) {
+        updateRects();
+    }
+
+    //! applets are not overlapping along the view length, the last applet
+    //! that starts before pos is the only candidate
+    const bool vertical = isVertical();
+    const qreal posStart = vertical ? pos.y() : pos.x();
+
+    auto candidate = std::upper_bound(m_entries.cbegin(), m_entries.cend(), posStart, [vertical](qreal start, const Entry &entry) {
+        return start < (vertical ? entry.rect.top() : entry.rect.left());
+    });
+
+    //! hidden applets have empty rectangles, they are skipped
+    while (candidate != m_entries.cbegin()) {
+        --candidate;
+
+        if (candidate->rect.isEmpty()) {
+            continue;
+        }
+
+        if (!candidate->rect.contains(pos) || !candidate->applet) {
+            return nullptr;
+        }
+
+        if (candidate->systray) {
+            if (inSystray) {
+                *inSystray = true;
+            }
+
+            return systrayAppletAt(candidate->systray, pos);
+        }
+
+        return candidate->applet;
+    }
+
+    return nullptr;
+}
+
+}
+}
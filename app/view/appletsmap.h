@@ -0,0 +1,110 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef APPLETSMAP_H
+#define APPLETSMAP_H
+
+// Qt
+#include <QObject>
+#include <QPointer>
+#include <QPointF>
+#include <QQuickItem>
+#include <QRectF>
+#include <QSet>
+#include <QVector>
+
+namespace Plasma {
+class Applet;
+class Containment;
+}
+
+namespace Latte {
+class View;
+}
+
+namespace Latte {
+namespace ViewPart {
+
+//! Spatial map of the applets of a view. The applet items are resolved only
+//! when applets are added or removed and their rectangles are recalculated
+//! only after their geometries changed. Rectangles are sorted along the view
+//! length in order for appletAt() to be a binary search. Applets inside
+//! systrays are resolved through the systray containment that is also
+//! identified only once.
+class AppletsMap : public QObject
+{
+    Q_OBJECT
+
+public:
+    AppletsMap(Latte::View *view);
+    ~AppletsMap() override;
+
+    //! the applet under pos in view contentItem coordinates, when a systray is
+    //! found under pos then its nested applet is returned or nullptr if there is none
+    Plasma::Applet *appletAt(const QPointF &pos, bool *inSystray = nullptr);
+
+    //! drops all the applets, tracked items and the containment, it is
+    //! used when the view is released from its containment
+    void reset();
+
+public slots:
+    //! applets must be resolved again
+    void invalidate();
+
+private slots:
+    //! only rectangles must be recalculated
+    void geometryChanged();
+    //! rectangles must be recalculated and the tracked parents chains walked again
+    void parentChanged();
+
+private:
+    struct Entry {
+        QPointer<Plasma::Applet> applet;
+        QPointer<QQuickItem> item;
+        QPointer<Plasma::Containment> systray;
+        QRectF rect;
+    };
+
+    void setContainment(Plasma::Containment *containment);
+    void updateEntries();
+    void updateRects();
+
+    void updateTracking();
+
+    bool isVertical() const;
+
+    QQuickItem *appletItemFor(Plasma::Applet *applet) const;
+    Plasma::Containment *systrayFor(Plasma::Applet *applet) const;
+    Plasma::Applet *systrayAppletAt(Plasma::Containment *systray, const QPointF &pos) const;
+
+private:
+    bool m_entriesDirty{true};
+    bool m_rectsDirty{true};
+
+    QVector<Entry> m_entries;
+    QSet<QQuickItem *> m_trackedItems;
+
+    QPointer<Plasma::Containment> m_containment;
+    Latte::View *m_latteView{nullptr};
+};
+
+}
+}
+
+#endif
@@ -49,6 +49,16 @@ ContainmentInterface::~ContainmentInterface()
 {
 }
 
+void ContainmentInterface::reset()
+{
+    m_mainItem.clear();
+
+    m_activateEntryMethod = QMetaMethod();
+    m_appletIdForIndexMethod = QMetaMethod();
+    m_newInstanceMethod = QMetaMethod();
+    m_showShortcutsMethod = QMetaMethod();
+}
+
 void ContainmentInterface::identifyMainItem()
 {
     if (m_mainItem) {
@@ -62,6 +62,10 @@ public:
     int applicationLauncherId() const;
     int appletIdForIndex(const int index);
 
+    //! forgets the main item of the containment, it is identified again
+    //! the next time it is needed e.g. when the view gets a new containment
+    void reset();
+
 private slots:
     void identifyMainItem();
     void identifyMethods();
@@ -20,6 +20,7 @@
 #include "contextmenu.h"
 
 // local
+#include "appletsmap.h"
 #include "view.h"
 #include "visibilitymanager.h"
 #include "../lattecorona.h"
@@ -38,13 +39,13 @@
 #include <Plasma/Containment>
 #include <Plasma/ContainmentActions>
 #include <Plasma/Corona>
-#include <PlasmaQuick/AppletQuickItem>
 
 namespace Latte {
 namespace ViewPart {
 
 ContextMenu::ContextMenu(Latte::View *view) :
     QObject(view),
+    m_appletsMap(new AppletsMap(view)),
     m_latteView(view)
 {
 }
@@ -116,58 +117,9 @@ bool ContextMenu::mousePressEvent(QMouseEvent *event)
             event->accept();
             return;
         }*/
-        //FIXME: very inefficient appletAt() implementation
-        Plasma::Applet *applet = 0;
-        bool inSystray = false;
 
-        //! initialize the appletContainsMethod on the first right click
-        if (!m_appletContainsMethod.isValid()) {
-            updateAppletContainsMethod();
-        }
-
-        for (const Plasma::Applet *appletTemp : m_latteView->containment()->applets()) {
-            PlasmaQuick::AppletQuickItem *ai = appletTemp->property("_plasma_graphicObject").value<PlasmaQuick::AppletQuickItem *>();
-
-            bool appletContainsMouse = false;
-
-            if (m_appletContainsMethod.isValid()) {
-                QVariant retVal;
-                m_appletContainsMethod.invoke(m_appletContainsMethodItem, Qt::DirectConnection, Q_RETURN_ARG(QVariant, retVal)
-                                              , Q_ARG(QVariant, appletTemp->id()), Q_ARG(QVariant, event->pos()));
-                appletContainsMouse = retVal.toBool();
-            } else {
-                appletContainsMouse = ai->contains(ai->mapFromItem(m_latteView->contentItem(), event->pos()));
-            }
-
-            if (ai && ai->isVisible() && appletContainsMouse) {
-                applet = ai->applet();
-                KPluginMetaData meta = applet->kPackage().metadata();
-
-                //Try to find applets inside a systray
-                if (meta.pluginId() == "org.kde.plasma.systemtray" ||
-                    meta.pluginId() == "org.nomad.systemtray") {
-                    auto systrayId = applet->config().readEntry("SystrayContainmentId");
-                    applet = 0;
-                    inSystray = true;
-                    Plasma::Containment *cont = containmentById(systrayId.toInt());
-
-                    if (cont) {
-                        for (const Plasma::Applet *appletCont : cont->applets()) {
-                            PlasmaQuick::AppletQuickItem *ai2 = appletCont->property("_plasma_graphicObject").value<PlasmaQuick::AppletQuickItem *>();
-
-                            if (ai2 && ai2->isVisible() && ai2->contains(ai2->mapFromItem(m_latteView->contentItem(), event->pos()))) {
-                                applet = ai2->applet();
-                                break;
-                            }
-                        }
-                    }
-
-                    break;
-                } else {
-                    ai = 0;
-                }
-            }
-        }
+        bool inSystray{false};
+        Plasma::Applet *applet = m_appletsMap->appletAt(event->pos(), &inSystray);
 
         if (!applet && !inSystray) {
             applet = m_latteView->containment();
@@ -301,28 +253,6 @@ bool ContextMenu::mousePressEvent(QMouseEvent *event)
     //  PlasmaQuick::ContainmentView::mousePressEvent(event);
 }
 
-//! update the appletContainsPos method from Panel view
-void ContextMenu::updateAppletContainsMethod()
-{
-    for (QQuickItem *item : m_latteView->contentItem()->childItems()) {
-        if (auto *metaObject = item->metaObject()) {
-            // not using QMetaObject::invokeMethod to avoid warnings when calling
-            // this on applets that don't have it or other child items since this
-            // is pretty much trial and error.
-            // Also, "var" arguments are treated as QVariant in QMetaObject
-
-            int methodIndex = metaObject->indexOfMethod("appletContainsPos(QVariant,QVariant)");
-
-            if (methodIndex == -1) {
-                continue;
-            }
-
-            m_appletContainsMethod = metaObject->method(methodIndex);
-            m_appletContainsMethodItem = item;
-        }
-    }
-}
-
 void ContextMenu::addAppletActions(QMenu *desktopMenu, Plasma::Applet *applet, QEvent *event)
 {
     if (!m_latteView->containment()) {
@@ -456,16 +386,5 @@ void ContextMenu::addContainmentActions(QMenu *desktopMenu, QEvent *event)
     return;
 }
 
-Plasma::Containment *ContextMenu::containmentById(uint id)
-{
-    for (const auto containment : m_latteView->corona()->containments()) {
-        if (id == containment->id()) {
-            return containment;
-        }
-    }
-
-    return 0;
-}
-
 }
 }
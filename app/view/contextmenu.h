@@ -23,8 +23,6 @@
 // Qt
 #include <QEvent>
 #include <QMenu>
-#include <QMetaMethod>
-#include <QQuickItem>
 #include <QMouseEvent>
 #include <QObject>
 
@@ -35,6 +33,9 @@ class Containment;
 
 namespace Latte {
 class View;
+namespace ViewPart {
+class AppletsMap;
+}
 }
 
 namespace Latte {
@@ -61,14 +62,10 @@ private slots:
 private:
     void addAppletActions(QMenu *desktopMenu, Plasma::Applet *applet, QEvent *event);
     void addContainmentActions(QMenu *desktopMenu, QEvent *event);
-    void updateAppletContainsMethod();
-
-    Plasma::Containment *containmentById(uint id);
 
 private:
     QMenu *m_contextMenu{nullptr};
-    QMetaMethod m_appletContainsMethod;
-    QQuickItem *m_appletContainsMethodItem{nullptr};
+    AppletsMap *m_appletsMap{nullptr};
 
     Latte::View *m_latteView;
 
@@ -27,6 +27,7 @@
 
 // Qt
 #include <QRegion>
+#include <QScreen>
 
 // KDE
 #include <KWindowEffects>
@@ -48,6 +49,9 @@ Effects::~Effects()
 
 void Effects::init()
 {
+    m_compositorTimer.setSingleShot(true);
+    connect(&m_compositorTimer, &QTimer::timeout, this, &Effects::pushCompositorUpdates);
+
     connect(this, &Effects::backgroundOpacityChanged, this, &Effects::updateEffects);
     connect(this, &Effects::drawEffectsChanged, this, &Effects::updateEffects);
     connect(this, &Effects::rectChanged, this, &Effects::updateEffects);
@@ -340,47 +344,64 @@ void Effects::forceMaskRedraw()
     m_background->setImagePath(QStringLiteral("widgets/panel-background"));
     m_background->setEnabledBorders(m_enabledBorders);
 
+    m_maskPushed = false;
     updateMask();
 }
 
+QRegion Effects::backgroundMask(const QRect &area)
+{
+    //! this is used when compositing is disabled and provides
+    //! the correct way for the mask to be painted in order for
+    //! rounded corners to be shown correctly
+    if (!m_background) {
+        m_background = new Plasma::FrameSvg(this);
+    }
+
+    if (m_background->imagePath() != "widgets/panel-background") {
+        m_background->setImagePath(QStringLiteral("widgets/panel-background"));
+    }
+
+    m_background->setEnabledBorders(m_enabledBorders);
+    m_background->resizeFrame(area.size());
+    QRegion fixedMask = m_background->mask();
+    fixedMask.translate(area.x(), area.y());
+
+    //! fix for KF5.32 that return empty QRegion's for the mask
+    if (fixedMask.isEmpty()) {
+        fixedMask = QRegion(area);
+    }
+
+    return fixedMask;
+}
+
 void Effects::updateMask()
 {
+    m_maskDirty = true;
+    scheduleCompositorUpdate();
+}
+
+void Effects::pushMask()
+{
+    QRegion newMask;
+
     if (KWindowSystem::compositingActive()) {
-        if (m_view->behaveAsPlasmaPanel()) {
-            m_view->setMask(QRect());
-        } else {
-            m_view->setMask(subtractedMask());
+        if (!m_view->behaveAsPlasmaPanel()) {
+            newMask = subtractedMask();
         }
     } else {
-        //! this is used when compositing is disabled and provides
-        //! the correct way for the mask to be painted in order for
-        //! rounded corners to be shown correctly
-        //! the enabledBorders check was added because there was cases
-        //! that the mask region wasn't calculated correctly after location changes
-        if (!m_background) {
-            if (m_background && m_background->enabledBorders() != m_enabledBorders) {
-                delete m_background;
-            }
-
-            m_background = new Plasma::FrameSvg(this);
-        }
-
-        if (m_background->imagePath() != "widgets/panel-background") {
-            m_background->setImagePath(QStringLiteral("widgets/panel-background"));
-        }
+        newMask = backgroundMask(m_mask);
+    }
 
-        m_background->setEnabledBorders(m_enabledBorders);
-        m_background->resizeFrame(m_mask.size());
-        QRegion fixedMask = m_background->mask();
-        fixedMask.translate(m_mask.x(), m_mask.y());
+    if (m_maskPushed && m_pushedMask == newMask) {
+        m_pushesSkipped++;
+        return;
+    }
 
-        //! fix for KF5.32 that return empty QRegion's for the mask
-        if (fixedMask.isEmpty()) {
-            fixedMask = QRegion(m_mask);
-        }
+    m_view->setMask(newMask);
 
-        m_view->setMask(fixedMask);
-    }
+    m_maskPushed = true;
+    m_pushedMask = newMask;
+    m_pushesSent++;
 }
 
 void Effects::clearShadows()
@@ -398,6 +419,12 @@ void Effects::updateShadows()
 }
 
 void Effects::updateEffects()
+{
+    m_effectsDirty = true;
+    scheduleCompositorUpdate();
+}
+
+void Effects::pushEffects()
 {
     //! Don't apply any effect before the wayland surface is created under wayland
     //! https://bugs.kde.org/show_bug.cgi?id=392890
@@ -405,39 +432,82 @@ void Effects::updateEffects()
         return;
     }
 
-    if (m_drawEffects && !m_rect.isNull() && !m_rect.isEmpty()) {
-        //! this is used when compositing is disabled and provides
-        //! the correct way for the mask to be painted in order for
-        //! rounded corners to be shown correctly
-        if (!m_background) {
-            m_background = new Plasma::FrameSvg(this);
-        }
-
-        if (m_background->imagePath() != "widgets/panel-background") {
-            m_background->setImagePath(QStringLiteral("widgets/panel-background"));
-        }
+    EffectsState newEffects;
 
-        m_background->setEnabledBorders(m_enabledBorders);
-        m_background->resizeFrame(m_rect.size());
-        QRegion fixedMask = m_background->mask();
-        fixedMask.translate(m_rect.x(), m_rect.y());
+    if (m_drawEffects && !m_rect.isNull() && !m_rect.isEmpty()) {
+        newEffects.enabled = true;
+        newEffects.contrastEnabled = m_theme.backgroundContrastEnabled();
+        newEffects.contrast = m_backEffectContrast;
+        newEffects.intensity = m_backEffectIntesity;
+        newEffects.saturation = m_backEffectSaturation;
+        newEffects.region = backgroundMask(m_rect);
+    }
 
-        //! fix1, for KF5.32 that return empty QRegion's for the mask
-        if (fixedMask.isEmpty()) {
-            fixedMask = QRegion(m_rect);
-        }
+    if (m_effectsPushed && m_pushedEffects == newEffects) {
+        m_pushesSkipped++;
+        return;
+    }
 
-        KWindowEffects::enableBlurBehind(m_view->winId(), true, fixedMask);
+    if (newEffects.enabled) {
+        KWindowEffects::enableBlurBehind(m_view->winId(), true, newEffects.region);
         KWindowEffects::enableBackgroundContrast(m_view->winId(),
-                                                 m_theme.backgroundContrastEnabled(),
-                                                 m_backEffectContrast,
-                                                 m_backEffectIntesity,
-                                                 m_backEffectSaturation,
-                                                 fixedMask);
+                                                 newEffects.contrastEnabled,
+                                                 newEffects.contrast,
+                                                 newEffects.intensity,
+                                                 newEffects.saturation,
+                                                 newEffects.region);
     } else {
         KWindowEffects::enableBlurBehind(m_view->winId(), false);
         KWindowEffects::enableBackgroundContrast(m_view->winId(), false);
     }
+
+    m_effectsPushed = true;
+    m_pushedEffects = newEffects;
+    m_pushesSent++;
+}
+
+void Effects::scheduleCompositorUpdate()
+{
+    if (m_compositorTimer.isActive()) {
+        return;
+    }
+
+    QScreen *screen = m_view->screen();
+    qreal refreshRate = (screen && screen->refreshRate() > 0) ? screen->refreshRate() : 60;
+
+    m_compositorTimer.start(qMax(1, qRound(1000 / refreshRate)));
+}
+
+void Effects::pushCompositorUpdates()
+{
+    if (m_maskDirty) {
+        m_maskDirty = false;
+        pushMask();
+    }
+
+    if (m_effectsDirty) {
+        m_effectsDirty = false;
+        pushEffects();
+    }
+}
+
+void Effects::invalidateCompositorState()
+{
+    m_maskPushed = false;
+    m_effectsPushed = false;
+
+    updateMask();
+    updateEffects();
+}
+
+int Effects::compositorPushesSent() const
+{
+    return m_pushesSent;
+}
+
+int Effects::compositorPushesSkipped() const
+{
+    return m_pushesSkipped;
 }
 
 //!BEGIN draw panel shadows outside the dock window
@@ -25,6 +25,8 @@
 #include <QPointer>
 #include <QQuickView>
 #include <QRect>
+#include <QRegion>
+#include <QTimer>
 
 // Plasma
 #include <Plasma/FrameSvg>
@@ -91,6 +93,14 @@ public:
 
     Plasma::FrameSvg::EnabledBorders enabledBorders() const;
 
+    //! compositor updates statistics, mask/blur/contrast regions that were
+    //! sent and the ones that were skipped because nothing changed
+    int compositorPushesSent() const;
+    int compositorPushesSkipped() const;
+
+    //! the native window was recreated and it has no mask or effects any more
+    void invalidateCompositorState();
+
 public slots:
     Q_INVOKABLE void forceMaskRedraw();
 
@@ -117,9 +127,34 @@ private slots:
 
     void updateBackgroundContrastValues();
 
+    void pushCompositorUpdates();
+
 private:
+    struct EffectsState {
+        bool enabled{false};
+        bool contrastEnabled{false};
+        qreal contrast{1};
+        qreal intensity{1};
+        qreal saturation{1};
+        QRegion region;
+
+        bool operator==(const EffectsState &other) const {
+            return enabled == other.enabled && contrastEnabled == other.contrastEnabled
+                    && contrast == other.contrast && intensity == other.intensity
+                    && saturation == other.saturation && region == other.region;
+        }
+    };
+
     qreal currentMidValue(const qreal &max, const qreal &factor, const qreal &min) const;
 
+    //! all mask and effects changes are coalesced and are sent
+    //! to the compositor at most once per frame
+    void scheduleCompositorUpdate();
+    void pushMask();
+    void pushEffects();
+
+    QRegion backgroundMask(const QRect &area);
+
     QRegion subtractedMask();
     QRegion subtrackedMaskFromWindow(QRegion initialRegion, QQuickView *window);
 
@@ -141,6 +176,20 @@ private:
     QRect m_rect;
     QRect m_mask;
 
+    bool m_maskDirty{false};
+    bool m_effectsDirty{false};
+
+    //! last state that was sent to the compositor
+    bool m_maskPushed{false};
+    bool m_effectsPushed{false};
+    QRegion m_pushedMask;
+    EffectsState m_pushedEffects;
+
+    int m_pushesSent{0};
+    int m_pushesSkipped{0};
+
+    QTimer m_compositorTimer;
+
     QPointer<Latte::View> m_view;
 
     Plasma::Theme m_theme;
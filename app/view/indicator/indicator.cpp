@@ -24,6 +24,7 @@
 #include "../view.h"
 #include "../../lattecorona.h"
 #include "../../indicator/factory.h"
+#include "../../layouts/manager.h"
 #include "../../../liblatte2/types.h"
 
 // Qt
@@ -447,7 +448,9 @@ void Indicator::saveConfig()
     config.writeEntry("padding", m_padding);
     config.writeEntry("type", m_type);
 
-    config.sync();
+    if (m_corona) {
+        m_corona->layoutsManager()->persistence()->markDirty(config);
+    }
 }
 
 }
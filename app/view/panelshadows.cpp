@@ -68,6 +68,8 @@ public:
     void clearPixmaps();
     void setupPixmaps();
     Qt::HANDLE createPixmap(const QPixmap &source);
+    unsigned long tilePixmap(const QPixmap &source);
+    void releaseTilePixmap(unsigned long handle);
     void initPixmap(const QString &element);
     QPixmap initEmptyPixmap(const QSize &size);
     void updateShadow(const QWindow *window, Plasma::FrameSvg::EnabledBorders);
@@ -100,6 +102,11 @@ public:
     //! graphical context
     xcb_gcontext_t _gc;
     bool m_isX11;
+
+    //! every distinct shadow/empty tile is uploaded to the X server once
+    //! and it is shared from all the enabled borders combinations
+    QHash<qint64, unsigned long> m_x11Tiles;
+    QHash<unsigned long, int> m_x11TileRefs;
 #endif
 
     struct Wayland
@@ -261,6 +268,61 @@ Qt::HANDLE PanelShadows::Private::createPixmap(const QPixmap &source)
 
 }
 
+unsigned long PanelShadows::Private::tilePixmap(const QPixmap &source)
+{
+#if HAVE_X11
+    const qint64 key = source.cacheKey();
+
+    if (!m_x11Tiles.contains(key)) {
+        const unsigned long handle = reinterpret_cast<unsigned long>(createPixmap(source));
+
+        if (!handle) {
+            return 0;
+        }
+
+        m_x11Tiles[key] = handle;
+    }
+
+    const unsigned long handle = m_x11Tiles[key];
+    m_x11TileRefs[handle] = m_x11TileRefs.value(handle, 0) + 1;
+
+    return handle;
+#else
+    Q_UNUSED(source)
+    return 0;
+#endif
+}
+
+void PanelShadows::Private::releaseTilePixmap(unsigned long handle)
+{
+#if HAVE_X11
+
+    if (!handle || !m_x11TileRefs.contains(handle)) {
+        return;
+    }
+
+    if (--m_x11TileRefs[handle] > 0) {
+        return;
+    }
+
+    m_x11TileRefs.remove(handle);
+
+    for (auto it = m_x11Tiles.begin(); it != m_x11Tiles.end(); ++it) {
+        if (it.value() == handle) {
+            m_x11Tiles.erase(it);
+            break;
+        }
+    }
+
+    if (auto *display = QX11Info::display()) {
+        XFreePixmap(display, handle);
+    }
+
+#else
+    Q_UNUSED(handle)
+#endif
+}
+
 void PanelShadows::Private::initPixmap(const QString &element)
 {
     m_shadowPixmaps << q->pixmap(element);
@@ -325,78 +387,78 @@ void PanelShadows::Private::setupData(Plasma::FrameSvg::EnabledBorders enabledBo
 
     //shadow-top
     if (enabledBorders & Plasma::FrameSvg::TopBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[0]));
+        data[enabledBorders] << tilePixmap(m_shadowPixmaps[0]);
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyHorizontalPix));
+        data[enabledBorders] << tilePixmap(m_emptyHorizontalPix);
     }
 
     //shadow-topright
     if (enabledBorders & Plasma::FrameSvg::TopBorder &&
         enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[1]));
+        data[enabledBorders] << tilePixmap(m_shadowPixmaps[1]);
     } else if (enabledBorders & Plasma::FrameSvg::TopBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerTopPix));
+        data[enabledBorders] << tilePixmap(m_emptyCornerTopPix);
     } else if (enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerRightPix));
+        data[enabledBorders] << tilePixmap(m_emptyCornerRightPix);
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix));
+        data[enabledBorders] << tilePixmap(m_emptyCornerPix);
     }
 
     //shadow-right
     if (enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[2]));
+        data[enabledBorders] << tilePixmap(m_shadowPixmaps[2]);
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyVerticalPix));
+        data[enabledBorders] << tilePixmap(m_emptyVerticalPix);
     }
 
     //shadow-bottomright
     if (enabledBorders & Plasma::FrameSvg::BottomBorder &&
         enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[3]));
+        data[enabledBorders] << tilePixmap(m_shadowPixmaps[3]);
     } else if (enabledBorders & Plasma::FrameSvg::BottomBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerBottomPix));
+        data[enabledBorders] << tilePixmap(m_emptyCornerBottomPix);
     } else if (enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerRightPix));
+        data[enabledBorders] << tilePixmap(m_emptyCornerRightPix);
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix));
+        data[enabledBorders] << tilePixmap(m_emptyCornerPix);
     }
 
     //shadow-bottom
     if (enabledBorders & Plasma::FrameSvg::BottomBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[4]));
+        data[enabledBorders] << tilePixmap(m_shadowPixmaps[4]);
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyHorizontalPix));
+        data[enabledBorders] << tilePixmap(m_emptyHorizontalPix);
     }
 
     //shadow-bottomleft
     if (enabledBorders & Plasma::FrameSvg::BottomBorder &&
         enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[5]));
+        data[enabledBorders] << tilePixmap(m_shadowPixmaps[5]);
     } else if (enabledBorders & Plasma::FrameSvg::BottomBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerBottomPix));
+        data[enabledBorders] << tilePixmap(m_emptyCornerBottomPix);
     } else if (enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerLeftPix));
+        data[enabledBorders] << tilePixmap(m_emptyCornerLeftPix);
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix));
+        data[enabledBorders] << tilePixmap(m_emptyCornerPix);
     }
 
     //shadow-left
     if (enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[6]));
+        data[enabledBorders] << tilePixmap(m_shadowPixmaps[6]);
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyVerticalPix));
+        data[enabledBorders] << tilePixmap(m_emptyVerticalPix);
     }
 
     //shadow-topleft
     if (enabledBorders & Plasma::FrameSvg::TopBorder &&
         enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[7]));
+        data[enabledBorders] << tilePixmap(m_shadowPixmaps[7]);
     } else if (enabledBorders & Plasma::FrameSvg::TopBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerTopPix));
+        data[enabledBorders] << tilePixmap(m_emptyCornerTopPix);
     } else if (enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerLeftPix));
+        data[enabledBorders] << tilePixmap(m_emptyCornerLeftPix);
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix));
+        data[enabledBorders] << tilePixmap(m_emptyCornerPix);
     }
 
 #endif
@@ -464,45 +526,15 @@ void PanelShadows::Private::freeX11Pixmaps()
         return;
     }
 
-    auto *display = QX11Info::display();
-
-    if (!display) {
-        return;
-    }
-
-    for (const QPixmap &pixmap : m_shadowPixmaps) {
-        if (!pixmap.isNull()) {
-            XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(pixmap)));
+    //! the first eight values of each borders combination are its tile handles,
+    //! each tile is freed when the last combination that references it is released
+    for (auto it = data.constBegin(); it != data.constEnd(); ++it) {
+        for (int i = 0; i < qMin(8, it.value().size()); ++i) {
+            releaseTilePixmap(it.value()[i]);
         }
     }
 
-    if (!m_emptyCornerPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix)));
-    }
-
-    if (!m_emptyCornerBottomPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerBottomPix)));
-    }
-
-    if (!m_emptyCornerLeftPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerLeftPix)));
-    }
-
-    if (!m_emptyCornerRightPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerRightPix)));
-    }
-
-    if (!m_emptyCornerTopPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerTopPix)));
-    }
-
-    if (!m_emptyVerticalPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyVerticalPix)));
-    }
-
-    if (!m_emptyHorizontalPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyHorizontalPix)));
-    }
+    data.clear();
 
 #endif
 }
@@ -52,7 +52,16 @@ Positioner::Positioner(Latte::View *parent)
     //! is achieved
     m_validateGeometryTimer.setSingleShot(true);
     m_validateGeometryTimer.setInterval(500);
-    connect(&m_validateGeometryTimer, &QTimer::timeout, this, &Positioner::syncGeometry);
+    connect(&m_validateGeometryTimer, &QTimer::timeout, this, [&]() {
+        //! the computed geometry is still valid, it just needs to be applied again
+        invalidateGeometry(SizeStage);
+    });
+
+    //! all geometry invalidations of the same event loop turn are coalesced
+    //! into one geometry pass
+    m_syncGeometryTimer.setSingleShot(true);
+    m_syncGeometryTimer.setInterval(0);
+    connect(&m_syncGeometryTimer, &QTimer::timeout, this, &Positioner::updateGeometry);
 
     m_corona = qobject_cast<Latte::Corona *>(m_view->corona());
 
@@ -101,12 +110,15 @@ Positioner::~Positioner()
 
     m_screenSyncTimer.stop();
     m_validateGeometryTimer.stop();
+    m_syncGeometryTimer.stop();
 }
 
 void Positioner::init()
 {
     //! connections
-    connect(this, &Positioner::screenGeometryChanged, this, &Positioner::syncGeometry);
+    connect(this, &Positioner::screenGeometryChanged, this, [&]() {
+        invalidateGeometry(ScreenStage);
+    });
 
     connect(m_view, &QQuickWindow::xChanged, this, &Positioner::validateDockGeometry);
     connect(m_view, &QQuickWindow::yChanged, this, &Positioner::validateDockGeometry);
@@ -115,37 +127,47 @@ void Positioner::init()
     connect(m_view, &QQuickWindow::screenChanged, this, &Positioner::currentScreenChanged);
     connect(m_view, &QQuickWindow::screenChanged, this, &Positioner::screenChanged);
 
-    connect(m_view, &Latte::View::behaveAsPlasmaPanelChanged, this, &Positioner::syncGeometry);
-    connect(m_view, &Latte::View::maxThicknessChanged, this, &Positioner::syncGeometry);
-    connect(m_view, &Latte::View::maxLengthChanged, this, &Positioner::syncGeometry);
-    connect(m_view, &Latte::View::offsetChanged, this, &Positioner::syncGeometry);
+    connect(m_view, &Latte::View::behaveAsPlasmaPanelChanged, this, [&]() {
+        invalidateGeometry(FreeRegionStage);
+    });
+
+    //! the maximum rect depends on the view thickness in all modes
+    connect(m_view, &Latte::View::maxThicknessChanged, this, [&]() {
+        invalidateGeometry(MaximumRectStage);
+    });
+
+    connect(m_view, &Latte::View::maxLengthChanged, this, [&]() {
+        invalidateGeometry(SizeStage);
+    });
+
+    connect(m_view, &Latte::View::offsetChanged, this, [&]() {
+        invalidateGeometry(PositionStage);
+    });
 
     connect(m_view, &Latte::View::absoluteGeometryChanged, this, [&]() {
         if (m_view->behaveAsPlasmaPanel()) {
-            syncGeometry();
+            invalidateGeometry(SizeStage);
         }
     });
 
     connect(m_view, &Latte::View::locationChanged, this, [&]() {
         updateFormFactor();
-        syncGeometry();
+        invalidateGeometry(ScreenStage);
     });
 
     connect(m_view, &Latte::View::normalThicknessChanged, this, [&]() {
-        if (m_view->behaveAsPlasmaPanel()) {
-            syncGeometry();
-        }
+        invalidateGeometry(MaximumRectStage);
     });
 
     connect(m_view->effects(), &Latte::ViewPart::Effects::drawShadowsChanged, this, [&]() {
         if (!m_view->behaveAsPlasmaPanel()) {
-            syncGeometry();
+            invalidateGeometry(SizeStage);
         }
     });
 
     connect(m_view->effects(), &Latte::ViewPart::Effects::innerShadowChanged, this, [&]() {
         if (m_view->behaveAsPlasmaPanel()) {
-            syncGeometry();
+            invalidateGeometry(PositionStage);
         }
     });
 
@@ -239,7 +261,10 @@ void Positioner::setScreenToFollow(QScreen *scr, bool updateScreenId)
     }
 
     connect(scr, &QScreen::geometryChanged, this, &Positioner::screenGeometryChanged);
-    syncGeometry();
+
+    //! the new screen geometry must be applied before the absolute geometry is updated
+    invalidateGeometry(ScreenStage);
+    updateGeometry();
     m_view->updateAbsoluteGeometry(true);
     qDebug() << "setScreenToFollow() ended...";
 
@@ -307,7 +332,7 @@ void Positioner::reconsiderScreen()
         }
     }
 
-    syncGeometry();
+    invalidateGeometry(ScreenStage);
     qDebug() << "reconsiderScreen() ended...";
 }
 
@@ -325,84 +350,119 @@ void Positioner::screenChanged(QScreen *scr)
 
 void Positioner::syncGeometry()
 {
-    if (!(m_view->screen() && m_view->containment()) || m_inDelete) {
+    invalidateGeometry(AllStages);
+}
+
+void Positioner::invalidateGeometry(GeometryStages stages)
+{
+    if (m_inDelete) {
         return;
     }
 
-    bool found{false};
+    m_pendingStages |= stages;
+
+    if (!m_syncGeometryTimer.isActive()) {
+        m_syncGeometryTimer.start();
+    }
+}
+
+void Positioner::updateGeometry()
+{
+    m_syncGeometryTimer.stop();
 
-    qDebug() << "syncGeometry() called...";
+    if (!(m_view->screen() && m_view->containment()) || m_inDelete || m_pendingStages == NoStage) {
+        return;
+    }
 
     //! before updating the positioning and geometry of the dock
-    //! we make sure that the dock is at the correct screen
+    //! we make sure that the dock is at the correct screen, if it isnt
+    //! the pending stages are kept for the pass after the screen sync
     if (m_view->screen() != m_screenToFollow) {
         qDebug() << "Sync Geometry screens inconsistent!!!! ";
 
-        if (m_screenToFollow) {
-            qDebug() << "Sync Geometry screens inconsistent for m_screenToFollow:" << m_screenToFollow->name() << " dock screen:" << m_view->screen()->name();
-        }
-
         if (!m_screenSyncTimer.isActive()) {
             m_screenSyncTimer.start();
         }
-    } else {
-        found = true;
-    }
-
-    //! if the dock isnt at the correct screen the calculations
-    //! are not executed
-    if (found) {
-        //! compute the free screen rectangle for vertical panels only once
-        //! this way the costly QRegion computations are calculated only once
-        //! instead of two times (both inside the resizeWindow and the updatePosition)
-        QRegion freeRegion;;
-        QRect maximumRect;
-        QRect availableScreenRect{m_view->screen()->geometry()};
-
-        if (m_view->formFactor() == Plasma::Types::Vertical) {
-            QString layoutName = m_view->layout() ? m_view->layout()->name() : QString();
-            auto latteCorona = qobject_cast<Latte::Corona *>(m_view->corona());
-            int fixedScreen = m_view->onPrimary() ? latteCorona->screenPool()->primaryScreenId() : m_view->containment()->screen();
-
-            freeRegion = latteCorona->availableScreenRegionWithCriteria(fixedScreen, layoutName);
-            maximumRect = maximumNormalGeometry();
-            QRegion availableRegion = freeRegion.intersected(maximumRect);
-            availableScreenRect = freeRegion.intersected(maximumRect).boundingRect();
-            float area = 0;
-
-            //! it is used to choose which or the availableRegion rectangles will
-            //! be the one representing dock geometry
-            for (QRegion::const_iterator p_rect=availableRegion.begin(); p_rect!=availableRegion.end(); ++p_rect) {
-                //! the area of each rectangle in calculated in squares of 50x50
-                //! this is a way to avoid enourmous numbers for area value
-                float tempArea = (float)((*p_rect).width() * (*p_rect).height()) / 2500;
-
-                if (tempArea > area) {
-                    availableScreenRect = (*p_rect);
-                    area = tempArea;
-                }
-            }
 
-            if (availableRegion.rectCount() > 1 && m_view->behaveAsPlasmaPanel()) {
-                m_view->effects()->setForceDrawCenteredBorders(true);
-            } else {
-                m_view->effects()->setForceDrawCenteredBorders(false);
-            }
-        } else {
-            m_view->effects()->setForceDrawCenteredBorders(false);
-        }
+        return;
+    }
+
+    //! cascade the invalidation to the dependent stages
+    GeometryStages stages = m_pendingStages;
+    m_pendingStages = NoStage;
+
+    if (stages & ScreenStage) {
+        stages |= (FreeRegionStage | MaximumRectStage);
+    }
+
+    if (stages & (FreeRegionStage | MaximumRectStage)) {
+        stages |= SizeStage;
+    }
 
-        m_view->effects()->updateEnabledBorders();
-        resizeWindow(availableScreenRect);
-        updatePosition(availableScreenRect);
+    if (stages & SizeStage) {
+        stages |= PositionStage;
+    }
+
+    bool isVertical = (m_view->formFactor() == Plasma::Types::Vertical);
+
+    //! the costly QRegion computations are needed only for vertical views
+    //! and only when the free screen region has really changed
+    if (isVertical && (stages & FreeRegionStage)) {
+        QString layoutName = m_view->layout() ? m_view->layout()->name() : QString();
+        int fixedScreen = m_view->onPrimary() ? m_corona->screenPool()->primaryScreenId() : m_view->containment()->screen();
+
+        m_freeRegion = m_corona->availableScreenRegionWithCriteria(fixedScreen, layoutName);
+    }
+
+    if (isVertical && (stages & MaximumRectStage)) {
+        m_maximumRect = maximumNormalGeometry();
+    }
 
-        qDebug() << "syncGeometry() calculations for screen: " << m_view->screen()->name() << " _ " << m_view->screen()->geometry();
-        qDebug() << "syncGeometry() calculations for edge: " << m_view->location();
+    if (stages & (FreeRegionStage | MaximumRectStage)) {
+        updateAvailableScreenRect();
     }
 
-    qDebug() << "syncGeometry() ended...";
+    m_view->effects()->updateEnabledBorders();
 
-    // qDebug() << "dock geometry:" << qRectToStr(geometry());
+    if (stages & SizeStage) {
+        resizeWindow(m_availableScreenRect);
+    }
+
+    if (stages & PositionStage) {
+        updatePosition(m_availableScreenRect);
+    }
+}
+
+void Positioner::updateAvailableScreenRect()
+{
+    if (m_view->formFactor() != Plasma::Types::Vertical) {
+        m_availableScreenRect = m_view->screen()->geometry();
+        m_view->effects()->setForceDrawCenteredBorders(false);
+        return;
+    }
+
+    QRegion availableRegion = m_freeRegion.intersected(m_maximumRect);
+    m_availableScreenRect = availableRegion.boundingRect();
+    float area = 0;
+
+    //! it is used to choose which or the availableRegion rectangles will
+    //! be the one representing dock geometry
+    for (QRegion::const_iterator p_rect=availableRegion.begin(); p_rect!=availableRegion.end(); ++p_rect) {
+        //! the area of each rectangle in calculated in squares of 50x50
+        //! this is a way to avoid enourmous numbers for area value
+        float tempArea = (float)((*p_rect).width() * (*p_rect).height()) / 2500;
+
+        if (tempArea > area) {
+            m_availableScreenRect = (*p_rect);
+            area = tempArea;
+        }
+    }
+
+    if (availableRegion.rectCount() > 1 && m_view->behaveAsPlasmaPanel()) {
+        m_view->effects()->setForceDrawCenteredBorders(true);
+    } else {
+        m_view->effects()->setForceDrawCenteredBorders(false);
+    }
 }
 
 void Positioner::validateDockGeometry()
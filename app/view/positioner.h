@@ -26,6 +26,7 @@
 // Qt
 #include <QObject>
 #include <QPointer>
+#include <QRegion>
 #include <QScreen>
 #include <QTimer>
 
@@ -52,6 +53,21 @@ class Positioner: public QObject
     Q_PROPERTY(QString currentScreenName READ currentScreenName NOTIFY currentScreenChanged)
 
 public:
+    //! the stages of the geometry pipeline, each stage invalidates
+    //! also the stages that depend on its results
+    //! Screen -> FreeRegion, MaximumRect -> Size -> Position
+    enum GeometryStage
+    {
+        NoStage = 0x0,
+        ScreenStage = 0x1,
+        FreeRegionStage = 0x2,
+        MaximumRectStage = 0x4,
+        SizeStage = 0x8,
+        PositionStage = 0x10,
+        AllStages = ScreenStage | FreeRegionStage | MaximumRectStage | SizeStage | PositionStage
+    };
+    Q_DECLARE_FLAGS(GeometryStages, GeometryStage)
+
     Positioner(Latte::View *parent);
     virtual ~Positioner();
 
@@ -63,12 +79,17 @@ public:
 
     void reconsiderScreen();
 
+    //! records that the inputs of these stages changed, all invalidations
+    //! of the same event loop turn are applied with one geometry pass
+    void invalidateGeometry(GeometryStages stages);
+
 public slots:
     Q_INVOKABLE void hideDockDuringLocationChange(int goToLocation);
     Q_INVOKABLE void hideDockDuringMovingToLayout(QString layoutName);
 
     Q_INVOKABLE bool setCurrentScreen(const QString id);
 
+    //! recomputes all geometry stages at the next geometry pass
     void syncGeometry();
 
 signals:
@@ -94,6 +115,7 @@ signals:
 private slots:
     void screenChanged(QScreen *screen);
     void validateDockGeometry();
+    void updateGeometry();
 
 private:
     void init();
@@ -104,6 +126,7 @@ private:
     void updatePosition(QRect availableScreenRect = QRect());
 
     QRect maximumNormalGeometry();
+    void updateAvailableScreenRect();
 
 private:
     bool m_inDelete{false};
@@ -120,6 +143,15 @@ private:
 
     QTimer m_validateGeometryTimer;
 
+    //! geometry pipeline state, the results of each stage are kept
+    //! in order to be reused when only later stages are invalidated
+    GeometryStages m_pendingStages{AllStages};
+    QTimer m_syncGeometryTimer;
+
+    QRegion m_freeRegion;
+    QRect m_maximumRect;
+    QRect m_availableScreenRect;
+
     //!used at sliding out/in animation
     QString m_moveToLayout;
     Plasma::Types::Location m_goToLocation{Plasma::Types::Floating};
@@ -131,4 +163,6 @@ private:
 }
 }
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(Latte::ViewPart::Positioner::GeometryStages)
+
 #endif
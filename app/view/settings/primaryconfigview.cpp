@@ -719,7 +719,10 @@ void PrimaryConfigView::saveConfig()
 
     auto config = m_latteView->containment()->config();
     config.writeEntry("settingsComplexity", (int)m_complexity);
-    config.sync();
+
+    if (m_corona) {
+        m_corona->layoutsManager()->persistence()->markDirty(config);
+    }
 }
 //!END configuration
 
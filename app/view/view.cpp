@@ -21,6 +21,7 @@
 #include "view.h"
 
 // local
+#include "appletsmap.h"
 #include "contextmenu.h"
 #include "effects.h"
 #include "positioner.h"
@@ -36,6 +37,7 @@
 #include "../settings/universalsettings.h"
 #include "../shortcuts/globalshortcuts.h"
 #include "../shortcuts/shortcutstracker.h"
+#include "../startuptracer.h"
 #include "../../liblatte2/extras.h"
 
 // Qt
@@ -169,7 +171,11 @@ View::~View()
     }
 
     disconnect(m_corona, &Latte::Corona::availableScreenRectChangedFrom, this, &View::availableScreenRectChangedFrom);
-    disconnect(containment(), SIGNAL(statusChanged(Plasma::Types::ItemStatus)), this, SLOT(statusChanged(Plasma::Types::ItemStatus)));
+
+    //! pooled views have no containment
+    if (containment()) {
+        disconnect(containment(), SIGNAL(statusChanged(Plasma::Types::ItemStatus)), this, SLOT(statusChanged(Plasma::Types::ItemStatus)));
+    }
 
     qDebug() << "dock view deleting...";
     rootContext()->setContextProperty(QStringLiteral("dock"), nullptr);
@@ -267,12 +273,25 @@ void View::init()
         rootContext()->setContextProperty(QStringLiteral("universalSettings"), m_corona->universalSettings());
     }
 
+    if (StartupTracer::isEnabled()) {
+        connect(this, &QQuickWindow::frameSwapped, this, &View::firstFrameSwapped);
+    }
+
+    StartupTracer::begin(QStringLiteral("view: load source"));
     setSource(corona()->kPackage().filePath("lattedockui"));
+    StartupTracer::end(QStringLiteral("view: load source"));
+
     m_positioner->syncGeometry();
 
     qDebug() << "SOURCE:" << source();
 }
 
+void View::firstFrameSwapped()
+{
+    disconnect(this, &QQuickWindow::frameSwapped, this, &View::firstFrameSwapped);
+    StartupTracer::firstFrameRendered();
+}
+
 void View::reloadSource()
 {
     if (m_layout && containment()) {
@@ -280,6 +299,8 @@ void View::reloadSource()
             m_configView->deleteLater();
         }
 
+        //! the loaded qml components are not valid any more
+        m_isReusable = false;
         engine()->clearComponentCache();
         m_layout->recreateView(containment(), settingsWindowIsShown());
     }
@@ -291,6 +312,11 @@ bool View::inDelete() const
     return m_inDelete;
 }
 
+bool View::isReusable() const
+{
+    return m_isReusable && !m_inDelete;
+}
+
 void View::disconnectSensitiveSignals()
 {
     disconnect(m_corona, &Latte::Corona::availableScreenRectChangedFrom, this, &View::availableScreenRectChangedFrom);
@@ -301,13 +327,79 @@ void View::disconnectSensitiveSignals()
     }
 }
 
+void View::connectSensitiveSignals()
+{
+    connect(m_corona, &Latte::Corona::availableScreenRectChangedFrom, this, &View::availableScreenRectChangedFrom, Qt::UniqueConnection);
+}
+
+void View::releaseContainment()
+{
+    if (!containment()) {
+        return;
+    }
+
+    hide();
+
+    m_visibleHackTimer1.stop();
+    m_visibleHackTimer2.stop();
+    m_releaseGrabTimer.stop();
+
+    if (m_configView) {
+        m_configView->deleteLater();
+    }
+
+    disconnect(containment(), SIGNAL(statusChanged(Plasma::Types::ItemStatus)), this, SLOT(statusChanged(Plasma::Types::ItemStatus)));
+
+    //! the layout connections are bound to the released containment, the
+    //! layout is reset in order for setLayout() to always rewire them
+    for (auto &c : connectionsLayout) {
+        disconnect(c);
+    }
+
+    connectionsLayout.clear();
+    m_layout = nullptr;
+
+    //! the released containment may still be alive e.g. when another view
+    //! takes its place, nothing may keep pointing to its qml items
+    if (m_interface) {
+        m_interface->reset();
+    }
+
+    if (m_contextMenu) {
+        m_contextMenu->m_appletsMap->reset();
+    }
+
+    //! these parts are bound to the containment during their creation and
+    //! they are recreated when the view is assigned a new containment
+    if (m_indicator) {
+        m_indicator->unloadIndicators();
+        delete m_indicator;
+        m_indicator = nullptr;
+        emit indicatorChanged();
+    }
+
+    if (m_visibility) {
+        delete m_visibility;
+        m_visibility = nullptr;
+        emit visibilityChanged();
+    }
+
+    if (m_windowsTracker) {
+        delete m_windowsTracker;
+        m_windowsTracker = nullptr;
+        emit windowsTrackerChanged();
+    }
+
+    setContainment(nullptr);
+}
+
 void View::availableScreenRectChangedFrom(View *origin)
 {
     if (m_inDelete || origin == this)
         return;
 
     if (formFactor() == Plasma::Types::Vertical) {
-        m_positioner->syncGeometry();
+        m_positioner->invalidateGeometry(ViewPart::Positioner::FreeRegionStage);
     }
 
 }
@@ -1195,6 +1287,7 @@ bool View::event(QEvent *e)
                 switch (pe->surfaceEventType()) {
                 case QPlatformSurfaceEvent::SurfaceCreated:
                     setupWaylandIntegration();
+                    m_effects->invalidateCompositorState();
 
                     if (m_shellSurface) {
                         m_positioner->syncGeometry();
@@ -1372,7 +1465,10 @@ void View::saveConfig()
     config.writeEntry("byPassWM", byPassWM());
     config.writeEntry("isPreferredForShortcuts", isPreferredForShortcuts());
     config.writeEntry("viewType", (int)m_type);
-    config.sync();
+
+    if (m_corona) {
+        m_corona->layoutsManager()->persistence()->markDirty(config);
+    }
 }
 
 void View::restoreConfig()
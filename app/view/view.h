@@ -128,6 +128,8 @@ public:
     void setAlternativesIsShown(bool show);
 
     bool inDelete() const;
+    //! false when the view window must not be reused for other containments
+    bool isReusable() const;
 
     bool onPrimary() const;
     void setOnPrimary(bool flag);
@@ -216,6 +218,11 @@ public:
     //! these are signals that create crashes, such a example is the availableScreenRectChanged from corona
     //! when its containment is destroyed
     void disconnectSensitiveSignals();
+    void connectSensitiveSignals();
+
+    //! unbinds the view from its containment and unloads all the parts that are
+    //! bound to it, the hidden view can afterwards be used for another containment
+    void releaseContainment();
 
 public slots:
     Q_INVOKABLE void copyView();
@@ -294,6 +301,7 @@ signals:
 private slots:
     void availableScreenRectChangedFrom(View *origin);
     void configViewCreatedFor(Latte::View *view);
+    void firstFrameSwapped();
     void hideWindowsForSlidingOut();
     void preferredViewForShortcutsChangedSlot(Latte::View *view);
     void releaseGrab();
@@ -322,6 +330,7 @@ private:
     bool m_inDelete{false};
     bool m_inEditMode{false};
     bool m_isPreferredForShortcuts{false};
+    bool m_isReusable{true};
     bool m_latteTasksArePresent{false};
     bool m_onPrimary{true};
 
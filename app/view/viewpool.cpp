@@ -0,0 +1,135 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "viewpool.h"
+
+// local
+#include "view.h"
+#include "../lattecorona.h"
+#include "../indicator/factory.h"
+
+// Qt
+#include <QDebug>
+#include <QGuiApplication>
+#include <QScreen>
+
+namespace Latte {
+
+namespace {
+//! maximum number of views that are kept hidden for reuse
+const int DEFAULTCAPACITY = 4;
+}
+
+ViewPool::ViewPool(Latte::Corona *corona)
+    : QObject(corona),
+      m_capacity(DEFAULTCAPACITY),
+      m_corona(corona)
+{
+    //! pooled views hold QML components that become stale when indicators are updated
+    connect(m_corona->indicatorFactory(), &Latte::Indicator::Factory::pluginsUpdated, this, &ViewPool::clear);
+}
+
+ViewPool::~ViewPool()
+{
+    clear();
+}
+
+int ViewPool::capacity() const
+{
+    return m_capacity;
+}
+
+void ViewPool::setCapacity(int capacity)
+{
+    m_capacity = qMax(0, capacity);
+
+    while (m_views.count() > m_capacity) {
+        delete m_views.takeFirst().data();
+    }
+}
+
+int ViewPool::count() const
+{
+    return m_views.count();
+}
+
+Latte::View *ViewPool::acquire(QScreen *targetScreen, bool byPassWM)
+{
+    for (int i = 0; i < m_views.count(); ++i) {
+        auto view = m_views[i];
+
+        if (!view) {
+            m_views.removeAt(i);
+            --i;
+            continue;
+        }
+
+        bool viewByPassWM = view->flags() & Qt::BypassWindowManagerHint;
+
+        if (viewByPassWM == byPassWM) {
+            m_views.removeAt(i);
+            qDebug() << "view pool :: reusing view, pooled views remaining:" << m_views.count();
+
+            view->positioner()->setScreenToFollow(targetScreen ? targetScreen : qGuiApp->primaryScreen());
+            view->connectSensitiveSignals();
+
+            return view;
+        }
+    }
+
+    return create(targetScreen, byPassWM);
+}
+
+Latte::View *ViewPool::create(QScreen *targetScreen, bool byPassWM)
+{
+    auto view = new Latte::View(m_corona, targetScreen, byPassWM);
+    view->init();
+
+    return view;
+}
+
+bool ViewPool::release(Latte::View *view)
+{
+    if (!view) {
+        return true;
+    }
+
+    view->disconnectSensitiveSignals();
+
+    if (m_views.count() >= m_capacity || !view->isReusable() || !view->containment()) {
+        return false;
+    }
+
+    view->releaseContainment();
+    m_views << QPointer<Latte::View>(view);
+
+    qDebug() << "view pool :: view released, pooled views:" << m_views.count();
+
+    return true;
+}
+
+void ViewPool::clear()
+{
+    while (!m_views.isEmpty()) {
+        //! pooled views are hidden and unbound, they can be deleted directly
+        delete m_views.takeFirst().data();
+    }
+}
+
+}
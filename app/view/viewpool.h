@@ -0,0 +1,76 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef VIEWPOOL_H
+#define VIEWPOOL_H
+
+// Qt
+#include <QList>
+#include <QObject>
+#include <QPointer>
+
+class QScreen;
+
+namespace Latte {
+class Corona;
+class View;
+}
+
+namespace Latte {
+
+//! ViewPool recycles Latte::View windows. Views that are removed during
+//! layout switches, screen changes or view recreations are unbound from
+//! their containment and kept hidden, so the next view that is requested
+//! reuses their window, scene graph and loaded QML instead of creating
+//! them again. Views are reused only with the same window flags.
+class ViewPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    ViewPool(Latte::Corona *corona);
+    ~ViewPool() override;
+
+    int capacity() const;
+    void setCapacity(int capacity);
+
+    int count() const;
+
+    //! returns an initialized view without containment for targetScreen
+    Latte::View *acquire(QScreen *targetScreen, bool byPassWM);
+    //! always creates a new view, it is used when the window must be rebuilt
+    Latte::View *create(QScreen *targetScreen, bool byPassWM);
+    //! the view is unbound from its containment and kept for reuse, returns
+    //! false when the pool can not keep it and the caller must delete it
+    bool release(Latte::View *view);
+
+public slots:
+    void clear();
+
+private:
+    int m_capacity{0};
+
+    QList<QPointer<Latte::View>> m_views;
+
+    Latte::Corona *m_corona{nullptr};
+};
+
+}
+
+#endif
@@ -82,21 +82,10 @@ VisibilityManager::VisibilityManager(PlasmaQuick::ContainmentView *view)
 
     m_timerStartUp.setInterval(5000);
     m_timerStartUp.setSingleShot(true);
-    m_timerShow.setSingleShot(true);
-    m_timerHide.setSingleShot(true);
+    m_timerTransition.setSingleShot(true);
+    connect(&m_timerTransition, &QTimer::timeout, this, &VisibilityManager::onTransitionTimeout);
 
-    connect(&m_timerShow, &QTimer::timeout, this, [&]() {
-        if (m_isHidden) {
-            //   qDebug() << "must be shown";
-            emit mustBeShown();
-        }
-    });
-    connect(&m_timerHide, &QTimer::timeout, this, [&]() {
-        if (!m_blockHiding && !m_isHidden && !m_dragEnter) {
-            //   qDebug() << "must be hide";
-            emit mustBeHide();
-        }
-    });
+    m_stateTimer.start();
 
     restoreConfig();
 }
@@ -137,8 +126,9 @@ void VisibilityManager::setMode(Latte::Types::Visibility mode)
         m_wm->removeViewStruts(*m_latteView);
     }
 
-    m_timerShow.stop();
-    m_timerHide.stop();
+    m_timerTransition.stop();
+    m_hideRequested = false;
+    setState(m_isHidden ? HiddenState : ShownState);
     m_mode = mode;
 
     if (mode != Types::AlwaysVisible && mode != Types::WindowsGoBelow) {
@@ -195,42 +185,60 @@ void VisibilityManager::setMode(Latte::Types::Visibility mode)
     }
 
     case Types::AutoHide: {
-        m_connections[base] = connect(this, &VisibilityManager::containsMouseChanged, this, [&]() {
-            raiseView(m_containsMouse);
-        });
+        m_connections[base] = connect(this, &VisibilityManager::containsMouseChanged
+                                      , this, &VisibilityManager::updateHiddenState);
 
-        raiseView(m_containsMouse);
+        updateHiddenState();
         break;
     }
 
     case Types::DodgeActive: {
+        initWindowsState();
+
         m_connections[base] = connect(this, &VisibilityManager::containsMouseChanged
-                                      , this, &VisibilityManager::dodgeActive);
+                                      , this, &VisibilityManager::updateHiddenState);
         m_connections[base+1] = connect(m_latteView->windowsTracker()->currentScreen(), &TrackerPart::CurrentScreenTracker::activeWindowTouchingChanged
-                                        , this, &VisibilityManager::dodgeActive);
+                                        , this, [&]() {
+            m_activeWindowTouching = m_latteView->windowsTracker()->currentScreen()->activeWindowTouching();
+            updateHiddenState();
+        });
 
-        dodgeActive();
+        updateHiddenState();
         break;
     }
 
     case Types::DodgeMaximized: {
+        initWindowsState();
+
         m_connections[base] = connect(this, &VisibilityManager::containsMouseChanged
-                                      , this, &VisibilityManager::dodgeMaximized);
+                                      , this, &VisibilityManager::updateHiddenState);
         m_connections[base+1] = connect(m_latteView->windowsTracker()->currentScreen(), &TrackerPart::CurrentScreenTracker::activeWindowMaximizedChanged
-                                        , this, &VisibilityManager::dodgeMaximized);
+                                        , this, [&]() {
+            m_activeWindowMaximized = m_latteView->windowsTracker()->currentScreen()->activeWindowMaximized();
+            updateHiddenState();
+        });
 
-        dodgeMaximized();
+        updateHiddenState();
         break;
     }
 
     case Types::DodgeAllWindows: {
-        m_connections[base] = connect(this, &VisibilityManager::containsMouseChanged
-                                      , this, &VisibilityManager::dodgeAllWindows);
+        initWindowsState();
 
-        m_connections[base+1] = connect(m_latteView->windowsTracker()->currentScreen(), &TrackerPart::CurrentScreenTracker::existsWindowTouchingChanged
-                                        , this, &VisibilityManager::dodgeAllWindows);
+        m_connections[base] = connect(this, &VisibilityManager::containsMouseChanged
+                                      , this, &VisibilityManager::updateHiddenState);
+        m_connections[base+1] = connect(m_latteView->windowsTracker()->currentScreen(), &TrackerPart::CurrentScreenTracker::activeWindowTouchingChanged
+                                        , this, [&]() {
+            m_activeWindowTouching = m_latteView->windowsTracker()->currentScreen()->activeWindowTouching();
+            updateHiddenState();
+        });
+        m_connections[base+2] = connect(m_latteView->windowsTracker()->currentScreen(), &TrackerPart::CurrentScreenTracker::existsWindowTouchingChanged
+                                        , this, [&]() {
+            m_existsWindowTouching = m_latteView->windowsTracker()->currentScreen()->existsWindowTouching();
+            updateHiddenState();
+        });
 
-        dodgeAllWindows();
+        updateHiddenState();
         break;
     }
 
@@ -347,6 +355,23 @@ void VisibilityManager::setIsHidden(bool isHidden)
 
     m_isHidden = isHidden;
 
+    bool hideRequested = m_hideRequested;
+    m_hideRequested = false;
+
+    if (m_isHidden) {
+        if (m_state == ShownState && hideRequested) {
+            //! a raise was requested while the view was sliding out
+            //! because of a state machine hide
+            raiseView(true);
+        } else if (m_state != ShowPendingState) {
+            //! external hides e.g. location and screen changes slide-outs
+            //! do not schedule any raise
+            setState(HiddenState);
+        }
+    } else if (m_state != HidePendingState) {
+        setState(ShownState);
+    }
+
     updateGhostWindowState();
 
     emit isHiddenChanged();
@@ -367,11 +392,7 @@ void VisibilityManager::setBlockHiding(bool blockHiding)
     // qDebug() << "blockHiding:" << blockHiding;
 
     if (m_blockHiding) {
-        m_timerHide.stop();
-
-        if (m_isHidden) {
-            emit mustBeShown();
-        }
+        showNow();
     } else {
         updateHiddenState();
     }
@@ -381,33 +402,33 @@ void VisibilityManager::setBlockHiding(bool blockHiding)
 
 int VisibilityManager::timerShow() const
 {
-    return m_timerShow.interval();
+    return m_timerShowInterval;
 }
 
 void VisibilityManager::setTimerShow(int msec)
 {
-    if (m_timerShow.interval() == msec) {
+    if (m_timerShowInterval == msec) {
         return;
     }
 
-    m_timerShow.setInterval(msec);
+    m_timerShowInterval = msec;
     emit timerShowChanged();
 }
 
 int VisibilityManager::timerHide() const
 {
-    return m_timerHide.interval();
+    return m_timerHideInterval;
 }
 
 void VisibilityManager::setTimerHide(int msec)
 {
     int interval = qMax(HIDEMINIMUMINTERVAL, msec);
 
-    if (m_timerHide.interval() == interval) {
+    if (m_timerHideInterval == interval) {
         return;
     }
 
-    m_timerHide.setInterval(interval);
+    m_timerHideInterval = interval;
     emit timerHideChanged();
 }
 
@@ -447,25 +468,112 @@ void VisibilityManager::show()
 }
 
 
+VisibilityManager::VisibilityState VisibilityManager::state() const
+{
+    return m_state;
+}
+
+int VisibilityManager::stateTransitions() const
+{
+    return m_stateTransitions;
+}
+
+QVariantMap VisibilityManager::stateStatistics() const
+{
+    static const std::array<QString, StatesCount> names{{QStringLiteral("shown"), QStringLiteral("hidePending"),
+                                                         QStringLiteral("hidden"), QStringLiteral("showPending")}};
+
+    QVariantMap durations;
+
+    for (int i = 0; i < StatesCount; ++i) {
+        qint64 duration = m_stateDurations[i] + (i == m_state ? m_stateTimer.elapsed() : 0);
+        durations[names[i]] = duration;
+    }
+
+    QVariantMap statistics;
+    statistics["state"] = names[m_state];
+    statistics["transitions"] = m_stateTransitions;
+    statistics["timeInStates"] = durations;
+
+    return statistics;
+}
+
+void VisibilityManager::setState(VisibilityState state)
+{
+    if (m_state == state) {
+        return;
+    }
+
+    m_stateDurations[m_state] += m_stateTimer.restart();
+    m_state = state;
+    ++m_stateTransitions;
+
+    emit stateChanged();
+}
+
+void VisibilityManager::onTransitionTimeout()
+{
+    if (m_state == ShowPendingState) {
+        if (m_isHidden) {
+            //! the state becomes Shown when the sliding-in has finished
+            emit mustBeShown();
+        } else {
+            setState(ShownState);
+        }
+    } else if (m_state == HidePendingState) {
+        if (!m_blockHiding && !m_isHidden && !m_dragEnter) {
+            //! the state becomes Hidden when the sliding-out has finished
+            m_hideRequested = true;
+            emit mustBeHide();
+        } else {
+            setState(m_isHidden ? HiddenState : ShownState);
+        }
+    }
+}
+
+void VisibilityManager::showNow()
+{
+    m_timerTransition.stop();
+
+    if (m_isHidden) {
+        setState(ShowPendingState);
+        emit mustBeShown();
+    } else {
+        setState(ShownState);
+    }
+}
+
 void VisibilityManager::raiseView(bool raise)
 {
     if (m_blockHiding)
         return;
 
     if (raise) {
-        m_timerHide.stop();
-
-        if (!m_timerShow.isActive()) {
-            m_timerShow.start();
+        if (!m_isHidden) {
+            m_timerTransition.stop();
+            setState(ShownState);
+        } else if (m_state != ShowPendingState || !m_timerTransition.isActive()) {
+            //! the timer is armed again when a previous show request
+            //! was ignored from the containment
+            setState(ShowPendingState);
+            m_timerTransition.start(m_timerShowInterval);
         }
     } else if (!m_dragEnter) {
-        m_timerShow.stop();
-
-        if (m_hideNow) {
+        if (m_isHidden) {
+            m_hideNow = false;
+            m_timerTransition.stop();
+            setState(HiddenState);
+        } else if (m_hideNow) {
             m_hideNow = false;
+            m_timerTransition.stop();
+            setState(HidePendingState);
+            m_hideRequested = true;
             emit mustBeHide();
-        } else if (!m_timerHide.isActive()) {
-            m_timerHide.start();
+        } else if (m_state != HidePendingState || !m_timerTransition.isActive()) {
+            //! the timer is armed again when a previous hide request
+            //! was ignored from the containment
+            setState(HidePendingState);
+            m_timerTransition.start(m_timerHideInterval);
         }
     }
 }
@@ -476,93 +584,65 @@ void VisibilityManager::raiseViewTemporarily()
         return;
 
     m_raiseTemporarily = true;
-    m_timerHide.stop();
-    m_timerShow.stop();
-
-    if (m_isHidden)
-        emit mustBeShown();
+    showNow();
 
-    QTimer::singleShot(qBound(1800, 2 * m_timerHide.interval(), 3000), this, [&]() {
+    QTimer::singleShot(qBound(1800, 2 * m_timerHideInterval, 3000), this, [&]() {
         m_raiseTemporarily = false;
         m_hideNow = true;
         updateHiddenState();
     });
 }
 
-void VisibilityManager::updateHiddenState()
+void VisibilityManager::initWindowsState()
 {
-    if (m_dragEnter)
-        return;
+    auto currentScreen = m_latteView->windowsTracker()->currentScreen();
 
-    switch (m_mode) {
-    case Types::AutoHide:
-        raiseView(m_containsMouse);
-        break;
+    m_activeWindowTouching = currentScreen->activeWindowTouching();
+    m_activeWindowMaximized = currentScreen->activeWindowMaximized();
+    m_existsWindowTouching = currentScreen->existsWindowTouching();
+}
 
+bool VisibilityManager::windowsAllowRaise() const
+{
+    switch (m_mode) {
     case Types::DodgeActive:
-        dodgeActive();
-        break;
+        return !m_activeWindowTouching;
 
     case Types::DodgeMaximized:
-        dodgeMaximized();
-        break;
+        return !m_activeWindowMaximized;
 
     case Types::DodgeAllWindows:
-        dodgeAllWindows();
-        break;
+        return !(m_activeWindowTouching || m_existsWindowTouching);
 
     default:
-        break;
+        return false;
     }
 }
 
-void VisibilityManager::applyActivitiesToHiddenWindows(const QStringList &activities)
-{
-    if (m_edgeGhostWindow) {
-        m_wm->setWindowOnActivities(*m_edgeGhostWindow, activities);
-    }
-}
-
-void VisibilityManager::dodgeActive()
+void VisibilityManager::updateHiddenState()
 {
-    if (m_raiseTemporarily)
+    if (m_dragEnter || m_raiseTemporarily)
         return;
 
-    //!don't send false raiseView signal when containing mouse
-    if (m_containsMouse) {
-        raiseView(true);
-        return;
-    }
-
-    raiseView(!m_latteView->windowsTracker()->currentScreen()->activeWindowTouching());
-}
-
-void VisibilityManager::dodgeMaximized()
-{
-    if (m_raiseTemporarily)
-        return;
+    switch (m_mode) {
+    case Types::AutoHide:
+    case Types::DodgeActive:
+    case Types::DodgeMaximized:
+    case Types::DodgeAllWindows:
+        //!don't send false raiseView signal when containing mouse
+        raiseView(m_containsMouse || windowsAllowRaise());
+        break;
 
-    //!don't send false raiseView signal when containing mouse
-    if (m_containsMouse) {
-        raiseView(true);
-        return;
+    default:
+        break;
     }
-
-    raiseView(!m_latteView->windowsTracker()->currentScreen()->activeWindowMaximized());
 }
 
-void VisibilityManager::dodgeAllWindows()
+void VisibilityManager::applyActivitiesToHiddenWindows(const QStringList &activities)
 {
-    if (m_raiseTemporarily)
-        return;
-
-    if (m_containsMouse) {
-        raiseView(true);
+    if (m_edgeGhostWindow) {
+        m_wm->setWindowOnActivities(*m_edgeGhostWindow, activities);
     }
-
-    bool windowIntersects{m_latteView->windowsTracker()->currentScreen()->activeWindowTouching() || m_latteView->windowsTracker()->currentScreen()->existsWindowTouching()};
-
-    raiseView(!windowIntersects);
 }
 
 void VisibilityManager::saveConfig()
@@ -573,8 +653,8 @@ void VisibilityManager::saveConfig()
     auto config = m_latteView->containment()->config();
 
     config.writeEntry("enableKWinEdges", m_enableKWinEdgesFromUser);
-    config.writeEntry("timerShow", m_timerShow.interval());
-    config.writeEntry("timerHide", m_timerHide.interval());
+    config.writeEntry("timerShow", m_timerShowInterval);
+    config.writeEntry("timerHide", m_timerHideInterval);
     config.writeEntry("raiseOnDesktopChange", m_raiseOnDesktopChange);
     config.writeEntry("raiseOnActivityChange", m_raiseOnActivityChange);
 
@@ -588,8 +668,8 @@ void VisibilityManager::restoreConfig()
     }
 
     auto config = m_latteView->containment()->config();
-    m_timerShow.setInterval(config.readEntry("timerShow", 0));
-    m_timerHide.setInterval(qMax(HIDEMINIMUMINTERVAL, config.readEntry("timerHide", 700)));
+    m_timerShowInterval = config.readEntry("timerShow", 0);
+    m_timerHideInterval = qMax(HIDEMINIMUMINTERVAL, config.readEntry("timerHide", 700));
     emit timerShowChanged();
     emit timerHideChanged();
 
@@ -664,11 +744,7 @@ void VisibilityManager::viewEventManager(QEvent *ev)
 
     case QEvent::DragEnter:
         m_dragEnter = true;
-
-        if (m_isHidden) {
-            emit mustBeShown();
-        }
-
+        showNow();
         break;
 
     case QEvent::DragLeave:
@@ -728,15 +804,17 @@ void VisibilityManager::createEdgeGhostWindow()
             if (contains) {
                 raiseView(true);
             } else {
-                m_timerShow.stop();
+                if (m_state == ShowPendingState && m_timerTransition.isActive()) {
+                    m_timerTransition.stop();
+                    setState(HiddenState);
+                }
+
                 updateGhostWindowState();
             }
         });
 
         connect(m_edgeGhostWindow, &ScreenEdgeGhostWindow::dragEntered, this, [&]() {
-            if (m_isHidden) {
-                emit mustBeShown();
-            }
+            showNow();
         });
 
         m_connectionsKWinEdges[0] = connect(m_wm, &WindowSystem::AbstractWindowInterface::currentActivityChanged,
@@ -28,8 +28,10 @@
 #include "../../liblatte2/types.h"
 
 // Qt
+#include <QElapsedTimer>
 #include <QObject>
 #include <QTimer>
+#include <QVariantMap>
 
 // Plasma
 #include <Plasma/Containment>
@@ -67,6 +69,17 @@ class VisibilityManager : public QObject
     Q_PROPERTY(int timerHide READ timerHide WRITE setTimerHide NOTIFY timerHideChanged)
 
 public:
+    //! the states of the raise/hide state machine, pending states are the ones
+    //! that wait for the show/hide interval or for the sliding animation to finish
+    enum VisibilityState
+    {
+        ShownState = 0,
+        HidePendingState,
+        HiddenState,
+        ShowPendingState,
+        StatesCount
+    };
+
     explicit VisibilityManager(PlasmaQuick::ContainmentView *view);
     virtual ~VisibilityManager();
 
@@ -101,6 +114,12 @@ public:
 
     bool supportsKWinEdges() const;
 
+    //! profiling information of the state machine, state transitions
+    //! and the time in msecs spent in each state
+    VisibilityState state() const;
+    int stateTransitions() const;
+    QVariantMap stateStatistics() const;
+
 public slots:
     Q_INVOKABLE void hide();
     Q_INVOKABLE void show();
@@ -125,6 +144,8 @@ signals:
     void enableKWinEdgesChanged();
     void supportsKWinEdgesChanged();
 
+    void stateChanged();
+
 private slots:
     void saveConfig();
     void restoreConfig();
@@ -137,6 +158,15 @@ private:
 
     void raiseView(bool raise);
     void raiseViewTemporarily();
+    void showNow();
+
+    void setState(VisibilityState state);
+    void onTransitionTimeout();
+
+    //! dodge modes consume only the tracker changes, the tracker is read
+    //! once when the mode is applied
+    void initWindowsState();
+    bool windowsAllowRaise() const;
 
     //! KWin Edges Support functions
     void createEdgeGhostWindow();
@@ -149,9 +179,6 @@ private:
     QRect acceptableStruts();
 
 private slots:
-    void dodgeAllWindows();
-    void dodgeActive();
-    void dodgeMaximized();
     void updateHiddenState();
 
 private:
@@ -159,10 +186,24 @@ private:
     Types::Visibility m_mode{Types::None};
     std::array<QMetaObject::Connection, 5> m_connections;
 
-    QTimer m_timerShow;
-    QTimer m_timerHide;
+    //! one timer for both pending states, its interval
+    //! is the show or hide interval accordingly
+    QTimer m_timerTransition;
     QTimer m_timerStartUp;
 
+    int m_timerShowInterval{0};
+    int m_timerHideInterval{700};
+
+    VisibilityState m_state{ShownState};
+    int m_stateTransitions{0};
+    std::array<qint64, StatesCount> m_stateDurations{};
+    QElapsedTimer m_stateTimer;
+
+    //! cached windows tracker state for dodge modes
+    bool m_activeWindowTouching{false};
+    bool m_activeWindowMaximized{false};
+    bool m_existsWindowTouching{false};
+
     bool m_isHidden{false};
     bool m_dragEnter{false};
     bool m_blockHiding{false};
@@ -171,6 +212,8 @@ private:
     bool m_raiseOnDesktopChange{false};
     bool m_raiseOnActivityChange{false};
     bool m_hideNow{false};
+    //! the state machine has asked for a slide-out that has not finished yet
+    bool m_hideRequested{false};
 
     QRect m_publishedStruts;
 
@@ -21,6 +21,8 @@
 #include "abstractwindowinterface.h"
 
 // local
+#include "appdatacache.h"
+#include "windowsindex.h"
 #include "tracker/schemes.h"
 #include "tracker/windowstracker.h"
 #include "../lattecorona.h"
@@ -45,17 +47,15 @@ AbstractWindowInterface::AbstractWindowInterface(QObject *parent)
     m_corona = qobject_cast<Latte::Corona *>(parent);
     m_windowsTracker = new Tracker::Windows(this);
     m_schemesTracker = new Tracker::Schemes(this);
+    m_appDataCache = new AppDataCache(this);
+    m_screenEdges = new ScreenEdgesTable(this);
 
     rulesConfig = KSharedConfig::openConfig(QStringLiteral("taskmanagerrulesrc"));
 
     m_windowWaitingTimer.setInterval(150);
     m_windowWaitingTimer.setSingleShot(true);
 
-    connect(&m_windowWaitingTimer, &QTimer::timeout, this, [&]() {
-        WindowId wid = m_windowChangedWaiting;
-        m_windowChangedWaiting = QVariant();
-        emit windowChanged(wid);
-    });
+    connect(&m_windowWaitingTimer, &QTimer::timeout, this, &AbstractWindowInterface::flushWindowChanges);
 
     connect(this, &AbstractWindowInterface::windowRemoved, this, &AbstractWindowInterface::windowRemovedSlot);
 
@@ -103,6 +103,11 @@ Tracker::Windows *AbstractWindowInterface::windowsTracker() const
     return m_windowsTracker;
 }
 
+AppDataCache *AbstractWindowInterface::appDataCache() const
+{
+    return m_appDataCache;
+}
+
 bool AbstractWindowInterface::isIgnored(const WindowId &wid)
 {
     return m_ignoredWindows.contains(wid);
@@ -110,50 +115,12 @@ bool AbstractWindowInterface::isIgnored(const WindowId &wid)
 
 bool AbstractWindowInterface::isPlasmaDesktop(const QRect &wGeometry) const
 {
-    if (wGeometry.isEmpty()) {
-        return false;
-    }
-
-    for (const auto scr : qGuiApp->screens()) {
-        if (wGeometry == scr->geometry()) {
-            return true;
-        }
-    }
-
-    return false;
+    return m_screenEdges->isScreenGeometry(wGeometry);
 }
 
 bool AbstractWindowInterface::isPlasmaPanel(const QRect &wGeometry) const
-{     
-    if (wGeometry.isEmpty()) {
-        return false;
-    }
-
-    bool isTouchingHorizontalEdge{false};
-    bool isTouchingVerticalEdge{false};
-
-    for (const auto scr : qGuiApp->screens()) {
-        if (scr->geometry().contains(wGeometry.center())) {
-            if (wGeometry.y() == scr->geometry().y() || wGeometry.bottom() == scr->geometry().bottom()) {
-                isTouchingHorizontalEdge = true;
-            }
-
-            if (wGeometry.left() == scr->geometry().left() || wGeometry.right() == scr->geometry().right()) {
-                isTouchingVerticalEdge = true;
-            }
-
-            if (isTouchingVerticalEdge && isTouchingHorizontalEdge) {
-                break;
-            }
-        }
-    }
-
-    if ((isTouchingHorizontalEdge && wGeometry.height() < MAXPLASMAPANELTHICKNESS)
-            || (isTouchingVerticalEdge && wGeometry.width() < MAXPLASMAPANELTHICKNESS)) {
-        return true;
-    }
-
-    return false;
+{
+    return m_screenEdges->isEdgeGeometry(wGeometry, MAXPLASMAPANELTHICKNESS);
 }
 
 bool AbstractWindowInterface::isRegisteredPlasmaPanel(const WindowId &wid)
@@ -169,37 +136,35 @@ bool AbstractWindowInterface::inCurrentDesktopActivity(const WindowInfoWrap &win
 //! Register Latte Ignored Windows in order to NOT be tracked
 void AbstractWindowInterface::registerIgnoredWindow(WindowId wid)
 {
-    if (!wid.isNull() && !m_ignoredWindows.contains(wid)) {
-        m_ignoredWindows.append(wid);
+    if (!wid.isNull() && m_ignoredWindows.insert(wid)) {
         emit windowChanged(wid);
     }
 }
 
 void AbstractWindowInterface::unregisterIgnoredWindow(WindowId wid)
 {
-    if (m_ignoredWindows.contains(wid)) {
-        m_ignoredWindows.removeAll(wid);
+    if (m_ignoredWindows.remove(wid)) {
         emit windowRemoved(wid);
     }
 }
 
 void AbstractWindowInterface::registerPlasmaPanel(WindowId wid)
 {
-    if (!wid.isNull() && !m_plasmaPanels.contains(wid)) {
-        m_plasmaPanels.append(wid);
+    if (!wid.isNull() && m_plasmaPanels.insert(wid)) {
         emit windowChanged(wid);
     }
 }
 
 void AbstractWindowInterface::unregisterPlasmaPanel(WindowId wid)
 {
-    if (m_plasmaPanels.contains(wid)) {
-        m_plasmaPanels.removeAll(wid);
-    }
+    m_plasmaPanels.remove(wid);
 }
 
 void AbstractWindowInterface::windowRemovedSlot(WindowId wid)
 {
+    //! a removed window must not be reported again from a pending batch
+    m_windowsChangedWaiting.remove(wid);
+
     if (m_plasmaPanels.contains(wid)) {
         unregisterPlasmaPanel(wid);
     }
@@ -243,31 +208,52 @@ void AbstractWindowInterface::switchToPreviousActivity()
 }
 
 //! Delay window changed trigerring
-void AbstractWindowInterface::considerWindowChanged(WindowId wid)
+int AbstractWindowInterface::windowChangesInterval() const
 {
-    //! Consider if the windowChanged signal should be sent DIRECTLY or WAIT
+    return m_windowWaitingTimer.interval();
+}
 
-    if (m_windowChangedWaiting == wid && m_windowWaitingTimer.isActive()) {
-        //! window should be sent later
-        m_windowWaitingTimer.start();
-        return;
-    }
+void AbstractWindowInterface::setWindowChangesInterval(int interval)
+{
+    m_windowWaitingTimer.setInterval(qMax(0, interval));
+}
 
-    if (m_windowChangedWaiting != wid && !m_windowWaitingTimer.isActive()) {
-        //! window should be sent later
-        m_windowChangedWaiting = wid;
+int AbstractWindowInterface::windowChangesReceived() const
+{
+    return m_windowChangesReceived;
+}
+
+int AbstractWindowInterface::windowChangesFlushes() const
+{
+    return m_windowChangesFlushes;
+}
+
+void AbstractWindowInterface::considerWindowChanged(WindowId wid, WindowChanges changes)
+{
+    //! windows changes are accumulated until the deadline of the first pending
+    //! change expires, this way windows that alternate their changes e.g. in
+    //! tiling layouts can not defeat the batching
+    ++m_windowChangesReceived;
+    m_windowsChangedWaiting[wid] |= changes;
+
+    if (!m_windowWaitingTimer.isActive()) {
         m_windowWaitingTimer.start();
     }
+}
 
-    if (m_windowChangedWaiting != wid && m_windowWaitingTimer.isActive()) {
-        m_windowWaitingTimer.stop();
-        //! sent previous waiting window
-        emit windowChanged(m_windowChangedWaiting);
+void AbstractWindowInterface::flushWindowChanges()
+{
+    m_windowWaitingTimer.stop();
 
-        //! retrigger waiting for the upcoming window
-        m_windowChangedWaiting = wid;
-        m_windowWaitingTimer.start();
+    if (m_windowsChangedWaiting.isEmpty()) {
+        return;
     }
+
+    const WindowChangesBatch changes = m_windowsChangedWaiting;
+    m_windowsChangedWaiting.clear();
+
+    ++m_windowChangesFlushes;
+    emit windowsChanged(changes);
 }
 
 }
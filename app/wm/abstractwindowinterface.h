@@ -25,6 +25,7 @@
 #include "schemecolors.h"
 #include "tasktools.h"
 #include "windowinfowrap.h"
+#include "windowsindex.h"
 #include "tracker/windowstracker.h"
 #include "../liblatte2/types.h"
 #include "../liblatte2/extras.h"
@@ -54,6 +55,7 @@
 namespace Latte {
 class Corona;
 namespace WindowSystem {
+class AppDataCache;
 namespace Tracker {
 class Schemes;
 class Windows;
@@ -110,6 +112,7 @@ public:
     virtual bool windowCanBeMaximized(WindowId wid) const = 0;
 
     virtual QIcon iconFor(WindowId wid) const = 0;
+    virtual QString titleFor(WindowId wid) const = 0;
     virtual WindowId winIdFor(QString appId, QRect geometry) const = 0;
     virtual AppData appDataFor(WindowId wid) const = 0;
 
@@ -137,9 +140,22 @@ public:
     Tracker::Schemes *schemesTracker();
     Tracker::Windows *windowsTracker() const;
 
+    AppDataCache *appDataCache() const;
+
+    //! the time window in ms that window changes are batched before they are sent
+    int windowChangesInterval() const;
+    void setWindowChangesInterval(int interval);
+
+    //! window changes metrics, how many changes were received from the
+    //! window manager and in how many batches they were delivered
+    int windowChangesReceived() const;
+    int windowChangesFlushes() const;
+
 signals:
     void activeWindowChanged(WindowId wid);
-    void windowChanged(WindowId winfo);
+    void windowChanged(WindowId winfo, WindowChanges changes = AllChanges);
+    //! batched window changes that were delayed through considerWindowChanged()
+    void windowsChanged(const Latte::WindowSystem::WindowChangesBatch &changes);
     void windowAdded(WindowId wid);
     void windowRemoved(WindowId wid);
     void currentDesktopChanged();
@@ -153,33 +169,41 @@ protected:
 
     //! windows that must be ignored from tracking, a good example are Latte::Views and
     //! their Configuration windows
-    QList<WindowId> m_ignoredWindows;
+    WindowIdSet m_ignoredWindows;
     //! identified plasma panels
-    QList<WindowId> m_plasmaPanels;
+    WindowIdSet m_plasmaPanels;
 
     QPointer<KActivities::Consumer> m_activities;
 
-    //! Sending too fast plenty of signals for the same window
-    //! has no reason and can create HIGH CPU usage. This Timer
-    //! can delay the batch sending of signals for the same window
-    WindowId m_windowChangedWaiting;
+    //! Sending too fast plenty of signals for the same windows
+    //! has no reason and can create HIGH CPU usage. All windows that
+    //! changed are kept pending and they are sent as one batch when
+    //! the timer deadline expires, the deadline is not extended
+    WindowChangesBatch m_windowsChangedWaiting;
     QTimer m_windowWaitingTimer;
 
+    int m_windowChangesReceived{0};
+    int m_windowChangesFlushes{0};
+
     //! Plasma taskmanager rules ile
     KSharedConfig::Ptr rulesConfig;
 
-    void considerWindowChanged(WindowId wid);
+    void considerWindowChanged(WindowId wid, WindowChanges changes = AllChanges);
 
     bool isPlasmaDesktop(const QRect &wGeometry) const;
     bool isPlasmaPanel(const QRect &wGeometry) const;
 
 private slots:
     void windowRemovedSlot(WindowId wid);
+    void flushWindowChanges();
 
 private:
     Latte::Corona *m_corona;
     Tracker::Schemes *m_schemesTracker;
     Tracker::Windows *m_windowsTracker;
+
+    AppDataCache *m_appDataCache;
+    ScreenEdgesTable *m_screenEdges;
 };
 
 }
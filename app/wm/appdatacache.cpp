@@ -0,0 +1,200 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "appdatacache.h"
+
+// Qt
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+// KDE
+#include <KConfigGroup>
+#include <KSharedConfig>
+#include <KSycoca>
+
+namespace Latte {
+namespace WindowSystem {
+
+AppDataCache::AppDataCache(QObject *parent)
+    : QObject(parent)
+{
+    connect(KSycoca::self(), SIGNAL(databaseChanged(QStringList)), this, SLOT(clear()));
+}
+
+AppDataCache::~AppDataCache()
+{
+    if (m_persistent) {
+        save();
+    }
+}
+
+QString AppDataCache::key(const QString &windowClass, const QString &desktopFile, const QString &cmdLine)
+{
+    return windowClass + QLatin1Char('|') + desktopFile + QLatin1Char('|') + cmdLine;
+}
+
+bool AppDataCache::persistent() const
+{
+    return m_persistent;
+}
+
+void AppDataCache::setPersistent(bool persistent)
+{
+    if (m_persistent == persistent) {
+        return;
+    }
+
+    m_persistent = persistent;
+
+    if (m_persistent) {
+        load();
+    }
+}
+
+int AppDataCache::hits() const
+{
+    return m_hits;
+}
+
+int AppDataCache::misses() const
+{
+    return m_misses;
+}
+
+bool AppDataCache::find(const QString &key, AppData &data)
+{
+    auto cached = m_data.constFind(key);
+
+    if (cached == m_data.constEnd()) {
+        ++m_misses;
+        return false;
+    }
+
+    ++m_hits;
+    data = cached.value();
+    return true;
+}
+
+void AppDataCache::insert(const QString &key, const AppData &data)
+{
+    m_data[key] = data;
+    m_changed = true;
+}
+
+void AppDataCache::clear()
+{
+    if (m_data.isEmpty()) {
+        return;
+    }
+
+    qDebug() << "application data cache :: cleared" << m_data.count() << "entries...";
+    m_data.clear();
+    m_changed = true;
+}
+
+QString AppDataCache::sycocaStamp() const
+{
+    QFileInfo sycoca(KSycoca::absoluteFilePath());
+    return QString::number(sycoca.lastModified().toMSecsSinceEpoch());
+}
+
+void AppDataCache::load()
+{
+    KSharedConfigPtr cache = KSharedConfig::openConfig(QStringLiteral("lattedock-appdata"),
+                                                       KConfig::SimpleConfig,
+                                                       QStandardPaths::GenericCacheLocation);
+
+    KConfigGroup general(cache, "General");
+
+    //! the stored identifications are invalid when ksycoca changed while latte was not running
+    if (general.readEntry("sycoca", QString()) != sycocaStamp()) {
+        return;
+    }
+
+    for (const auto &groupName : cache->groupList()) {
+        if (groupName == QLatin1String("General")) {
+            continue;
+        }
+
+        KConfigGroup entry(cache, groupName);
+        const QString key = entry.readEntry("key", QString());
+
+        if (key.isEmpty() || m_data.contains(key)) {
+            continue;
+        }
+
+        AppData data;
+        data.id = entry.readEntry("id", QString());
+        data.name = entry.readEntry("name", QString());
+        data.genericName = entry.readEntry("genericName", QString());
+        data.url = QUrl(entry.readEntry("url", QString()));
+        data.skipTaskbar = entry.readEntry("skipTaskbar", false);
+
+        //! only theme icons can be restored, the rest are requested again from their windows
+        const QString iconName = entry.readEntry("icon", QString());
+
+        if (!iconName.isEmpty()) {
+            data.icon = QIcon::fromTheme(iconName);
+        }
+
+        m_data[key] = data;
+    }
+
+    m_changed = false;
+}
+
+void AppDataCache::save()
+{
+    if (!m_changed) {
+        return;
+    }
+
+    KSharedConfigPtr cache = KSharedConfig::openConfig(QStringLiteral("lattedock-appdata"),
+                                                       KConfig::SimpleConfig,
+                                                       QStandardPaths::GenericCacheLocation);
+
+    for (const auto &groupName : cache->groupList()) {
+        cache->deleteGroup(groupName);
+    }
+
+    KConfigGroup general(cache, "General");
+    general.writeEntry("sycoca", sycocaStamp());
+
+    for (auto i = m_data.constBegin(); i != m_data.constEnd(); ++i) {
+        //! keys may contain any character, they are stored in their entries instead
+        const QString groupName = QString::fromLatin1(QCryptographicHash::hash(i.key().toUtf8(), QCryptographicHash::Sha1).toHex());
+        KConfigGroup entry(cache, groupName);
+
+        entry.writeEntry("key", i.key());
+        entry.writeEntry("id", i.value().id);
+        entry.writeEntry("name", i.value().name);
+        entry.writeEntry("genericName", i.value().genericName);
+        entry.writeEntry("url", i.value().url.toString());
+        entry.writeEntry("icon", i.value().icon.name());
+        entry.writeEntry("skipTaskbar", i.value().skipTaskbar);
+    }
+
+    cache->sync();
+    m_changed = false;
+}
+
+}
+}
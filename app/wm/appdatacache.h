@@ -0,0 +1,82 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef APPDATACACHE_H
+#define APPDATACACHE_H
+
+// local
+#include "tasktools.h"
+
+// Qt
+#include <QHash>
+#include <QObject>
+
+namespace Latte {
+namespace WindowSystem {
+
+//! Caches the application identification of windows. Resolving an application
+//! needs plenty of service database queries and icon loading, windows that are
+//! sharing the same window class, desktop file and command line are resolved
+//! only once. Windows that could not be identified are cached also, this way
+//! they are not queried again. The cache is cleared when ksycoca changes and
+//! it can optionally be stored in order to be reused after restarts.
+class AppDataCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    AppDataCache(QObject *parent = nullptr);
+    ~AppDataCache() override;
+
+    static QString key(const QString &windowClass, const QString &desktopFile, const QString &cmdLine);
+
+    bool persistent() const;
+    void setPersistent(bool persistent);
+
+    //! returns true when key has already been resolved, data is empty for
+    //! applications that could not be identified
+    bool find(const QString &key, AppData &data);
+    void insert(const QString &key, const AppData &data);
+
+    int hits() const;
+    int misses() const;
+
+public slots:
+    void clear();
+
+private:
+    void load();
+    void save();
+
+    QString sycocaStamp() const;
+
+private:
+    bool m_persistent{false};
+    bool m_changed{false};
+
+    int m_hits{0};
+    int m_misses{0};
+
+    QHash<QString, AppData> m_data;
+};
+
+}
+}
+
+#endif
@@ -30,7 +30,6 @@
 
 // KDE
 #include <KConfigGroup>
-#include <KDirWatch>
 #include <KSharedConfig>
 
 namespace Latte {
@@ -40,23 +39,22 @@ SchemeColors::SchemeColors(QObject *parent, QString scheme, bool plasmaTheme) :
     QObject(parent),
     m_basedOnPlasmaTheme(plasmaTheme)
 {
-    QString pSchemeFile = possibleSchemeFile(scheme);
+    SchemesRegistry *registry = SchemesRegistry::self();
+    QString pSchemeFile = registry->schemeFile(scheme);
 
     if (QFileInfo(pSchemeFile).exists()) {
         setSchemeFile(pSchemeFile);
-        m_schemeName = schemeName(pSchemeFile);
 
-        //! track scheme file for changes
-        KDirWatch::self()->addFile(m_schemeFile);
-
-        connect(KDirWatch::self(), &KDirWatch::dirty, this, [ & ](const QString & path) {
-            if (path == m_schemeFile) {
+        //! scheme file is tracked for changes only once from the registry
+        connect(registry, &SchemesRegistry::tableChanged, this, [ & ](const QString & file) {
+            if (file == m_schemeFile) {
                 updateScheme();
             }
         });
     }
 
-    updateScheme();
+    m_colors = registry->table(m_schemeFile);
+    m_schemeName = m_colors->name;
 }
 
 SchemeColors::~SchemeColors()
@@ -66,67 +64,67 @@ SchemeColors::~SchemeColors()
 
 QColor SchemeColors::backgroundColor() const
 {
-    return m_activeBackgroundColor;
+    return m_basedOnPlasmaTheme ? m_colors->viewBackgroundNormal : m_colors->wmActiveBackground;
 }
 
 QColor SchemeColors::textColor() const
 {
-    return m_activeTextColor;
+    return m_basedOnPlasmaTheme ? m_colors->viewForegroundNormal : m_colors->wmActiveForeground;
 }
 
 QColor SchemeColors::inactiveBackgroundColor() const
 {
-    return m_inactiveBackgroundColor;
+    return m_basedOnPlasmaTheme ? m_colors->viewBackgroundAlternate : m_colors->wmInactiveBackground;
 }
 
 QColor SchemeColors::inactiveTextColor() const
 {
-    return m_inactiveTextColor;
+    return m_basedOnPlasmaTheme ? m_colors->viewForegroundInactive : m_colors->wmInactiveForeground;
 }
 
 QColor SchemeColors::highlightColor() const
 {
-    return m_highlightColor;
+    return m_colors->selectionBackgroundNormal;
 }
 
 QColor SchemeColors::highlightedTextColor() const
 {
-    return m_highlightedTextColor;
+    return m_colors->selectionForegroundNormal;
 }
 
 QColor SchemeColors::positiveTextColor() const
 {
-    return m_positiveTextColor;
+    return m_colors->viewForegroundPositive;
 }
 
 QColor SchemeColors::neutralTextColor() const
 {
-    return m_neutralTextColor;
+    return m_colors->viewForegroundNeutral;
 }
 
 QColor SchemeColors::negativeTextColor() const
 {
-    return m_negativeTextColor;
+    return m_colors->viewForegroundNegative;
 }
 
 QColor SchemeColors::buttonTextColor() const
 {
-    return m_buttonTextColor;
+    return m_colors->buttonForegroundNormal;
 }
 
 QColor SchemeColors::buttonBackgroundColor() const
 {
-    return m_buttonBackgroundColor;
+    return m_colors->buttonBackgroundNormal;
 }
 
 QColor SchemeColors::buttonHoverColor() const
 {
-    return m_buttonHoverColor;
+    return m_colors->buttonDecorationHover;
 }
 
 QColor SchemeColors::buttonFocusColor() const
 {
-    return m_buttonFocusColor;
+    return m_colors->buttonDecorationFocus;
 }
 
 QString SchemeColors::schemeName() const
@@ -189,60 +187,13 @@ QString SchemeColors::schemeName(QString originalFile)
         return "";
     }
 
-    QString fileNameNoExt =  originalFile;
-
-    int lastSlash = originalFile.lastIndexOf("/");
-
-    if (lastSlash >= 0) {
-        fileNameNoExt.remove(0, lastSlash + 1);
-    }
-
-    if (fileNameNoExt.endsWith(".colors")) {
-        fileNameNoExt.remove(".colors");
-    }
-
-    KSharedConfigPtr filePtr = KSharedConfig::openConfig(originalFile);
-    KConfigGroup generalGroup = KConfigGroup(filePtr, "General");
-
-    return generalGroup.readEntry("Name", fileNameNoExt);
+    return SchemesRegistry::self()->table(originalFile)->name;
 }
 
 void SchemeColors::updateScheme()
 {
-    if (m_schemeFile.isEmpty() || !QFileInfo(m_schemeFile).exists()) {
-        return;
-    }
-
-    KSharedConfigPtr filePtr = KSharedConfig::openConfig(m_schemeFile);
-    KConfigGroup wmGroup = KConfigGroup(filePtr, "WM");
-    KConfigGroup selGroup = KConfigGroup(filePtr, "Colors:Selection");
-    KConfigGroup viewGroup = KConfigGroup(filePtr, "Colors:View");
-    //KConfigGroup windowGroup = KConfigGroup(filePtr, "Colors:Window");
-    KConfigGroup buttonGroup = KConfigGroup(filePtr, "Colors:Button");
-
-    if (!m_basedOnPlasmaTheme) {
-        m_activeBackgroundColor = wmGroup.readEntry("activeBackground", QColor());
-        m_activeTextColor = wmGroup.readEntry("activeForeground", QColor());
-        m_inactiveBackgroundColor = wmGroup.readEntry("inactiveBackground", QColor());
-        m_inactiveTextColor = wmGroup.readEntry("inactiveForeground", QColor());
-    } else {
-        m_activeBackgroundColor = viewGroup.readEntry("BackgroundNormal", QColor());
-        m_activeTextColor = viewGroup.readEntry("ForegroundNormal", QColor());
-        m_inactiveBackgroundColor = viewGroup.readEntry("BackgroundAlternate", QColor());
-        m_inactiveTextColor = viewGroup.readEntry("ForegroundInactive", QColor());
-    }
-
-    m_highlightColor = selGroup.readEntry("BackgroundNormal", QColor());
-    m_highlightedTextColor = selGroup.readEntry("ForegroundNormal", QColor());
-
-    m_positiveTextColor = viewGroup.readEntry("ForegroundPositive", QColor());
-    m_neutralTextColor = viewGroup.readEntry("ForegroundNeutral", QColor());;
-    m_negativeTextColor = viewGroup.readEntry("ForegroundNegative", QColor());
-
-    m_buttonTextColor = buttonGroup.readEntry("ForegroundNormal", QColor());
-    m_buttonBackgroundColor = buttonGroup.readEntry("BackgroundNormal", QColor());
-    m_buttonHoverColor = buttonGroup.readEntry("DecorationHover", QColor());
-    m_buttonFocusColor = buttonGroup.readEntry("DecorationFocus", QColor());
+    m_colors = SchemesRegistry::self()->table(m_schemeFile);
+    m_schemeName = m_colors->name;
 
     emit colorsChanged();
 }
@@ -21,9 +21,13 @@
 #ifndef SCHEMECOLORS_H
 #define SCHEMECOLORS_H
 
+// local
+#include "schemesregistry.h"
+
 // Qt
 #include <QObject>
 #include <QColor>
+#include <QSharedPointer>
 
 namespace Latte {
 namespace WindowSystem {
@@ -89,22 +93,8 @@ private:
     QString m_schemeName;
     QString m_schemeFile;
 
-    QColor m_activeBackgroundColor;
-    QColor m_activeTextColor;
-
-    QColor m_inactiveBackgroundColor;
-    QColor m_inactiveTextColor;
-
-    QColor m_highlightColor;
-    QColor m_highlightedTextColor;
-    QColor m_positiveTextColor;
-    QColor m_neutralTextColor;
-    QColor m_negativeTextColor;
-
-    QColor m_buttonTextColor;
-    QColor m_buttonBackgroundColor;
-    QColor m_buttonHoverColor;
-    QColor m_buttonFocusColor;
+    //! shared with all the SchemeColors that use the same scheme file
+    QSharedPointer<const SchemeColorsTable> m_colors;
 };
 
 }
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "schemesregistry.h"
+
+// local
+#include "schemecolors.h"
+
+// Qt
+#include <QDebug>
+#include <QFileInfo>
+
+// KDE
+#include <KConfig>
+#include <KConfigGroup>
+#include <KDirWatch>
+
+namespace Latte {
+namespace WindowSystem {
+
+class SchemesRegistrySingleton
+{
+public:
+    SchemesRegistrySingleton() {
+    }
+
+    SchemesRegistry self;
+};
+
+Q_GLOBAL_STATIC(SchemesRegistrySingleton, privateSchemesRegistrySelf)
+
+SchemesRegistry::SchemesRegistry(QObject *parent)
+    : QObject(parent),
+      m_emptyTable(new SchemeColorsTable)
+{
+    //! one connection for all the tracked scheme files
+    connect(KDirWatch::self(), &KDirWatch::dirty, this, &SchemesRegistry::fileChanged);
+    connect(KDirWatch::self(), &KDirWatch::created, this, &SchemesRegistry::fileChanged);
+    connect(KDirWatch::self(), &KDirWatch::deleted, this, &SchemesRegistry::fileChanged);
+}
+
+SchemesRegistry::~SchemesRegistry()
+{
+}
+
+SchemesRegistry *SchemesRegistry::self()
+{
+    return &privateSchemesRegistrySelf->self;
+}
+
+QSharedPointer<const SchemeColorsTable> SchemesRegistry::table(const QString &schemeFile)
+{
+    if (schemeFile.isEmpty()) {
+        return m_emptyTable;
+    }
+
+    if (m_tables.contains(schemeFile)) {
+        return m_tables[schemeFile];
+    }
+
+    if (!QFileInfo(schemeFile).exists()) {
+        return m_emptyTable;
+    }
+
+    QSharedPointer<const SchemeColorsTable> colors = parse(schemeFile);
+    m_tables[schemeFile] = colors;
+
+    //! track scheme file for changes
+    KDirWatch::self()->addFile(schemeFile);
+
+    return colors;
+}
+
+QString SchemesRegistry::schemeFile(const QString &scheme)
+{
+    if (scheme == "kdeglobals") {
+        return SchemeColors::possibleSchemeFile(scheme);
+    }
+
+    if (m_schemeFiles.contains(scheme)) {
+        return m_schemeFiles[scheme];
+    }
+
+    QString file = SchemeColors::possibleSchemeFile(scheme);
+
+    //! unknown schemes are not cached, they may be installed later
+    if (!file.isEmpty()) {
+        m_schemeFiles[scheme] = file;
+    }
+
+    return file;
+}
+
+void SchemesRegistry::reload(const QString &schemeFile)
+{
+    if (!m_tables.contains(schemeFile)) {
+        return;
+    }
+
+    m_tables[schemeFile] = QFileInfo(schemeFile).exists() ? parse(schemeFile) : m_emptyTable;
+    emit tableChanged(schemeFile);
+}
+
+void SchemesRegistry::fileChanged(const QString &path)
+{
+    if (!m_tables.contains(path)) {
+        return;
+    }
+
+    if (!QFileInfo(path).exists()) {
+        //! forget all the scheme names that were resolved to the removed file
+        for (auto it = m_schemeFiles.begin(); it != m_schemeFiles.end();) {
+            if (it.value() == path) {
+                it = m_schemeFiles.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    reload(path);
+}
+
+QSharedPointer<const SchemeColorsTable> SchemesRegistry::parse(const QString &schemeFile) const
+{
+    QSharedPointer<SchemeColorsTable> colors(new SchemeColorsTable);
+
+    //! a plain KConfig is used in order to not keep the file in KSharedConfig
+    //! cache after parsing, it still cascades to kdeglobals for the entries
+    //! that the scheme file does not provide
+    KConfig config(schemeFile);
+
+    KConfigGroup generalGroup(&config, "General");
+    KConfigGroup wmGroup(&config, "WM");
+    KConfigGroup selGroup(&config, "Colors:Selection");
+    KConfigGroup viewGroup(&config, "Colors:View");
+    KConfigGroup buttonGroup(&config, "Colors:Button");
+
+    QString fileNameNoExt = QFileInfo(schemeFile).fileName();
+
+    if (fileNameNoExt.endsWith(".colors")) {
+        fileNameNoExt.chop(7);
+    }
+
+    colors->name = generalGroup.readEntry("Name", fileNameNoExt);
+
+    colors->wmActiveBackground = wmGroup.readEntry("activeBackground", QColor());
+    colors->wmActiveForeground = wmGroup.readEntry("activeForeground", QColor());
+    colors->wmInactiveBackground = wmGroup.readEntry("inactiveBackground", QColor());
+    colors->wmInactiveForeground = wmGroup.readEntry("inactiveForeground", QColor());
+
+    colors->viewBackgroundNormal = viewGroup.readEntry("BackgroundNormal", QColor());
+    colors->viewBackgroundAlternate = viewGroup.readEntry("BackgroundAlternate", QColor());
+    colors->viewForegroundNormal = viewGroup.readEntry("ForegroundNormal", QColor());
+    colors->viewForegroundInactive = viewGroup.readEntry("ForegroundInactive", QColor());
+    colors->viewForegroundPositive = viewGroup.readEntry("ForegroundPositive", QColor());
+    colors->viewForegroundNeutral = viewGroup.readEntry("ForegroundNeutral", QColor());
+    colors->viewForegroundNegative = viewGroup.readEntry("ForegroundNegative", QColor());
+
+    colors->selectionBackgroundNormal = selGroup.readEntry("BackgroundNormal", QColor());
+    colors->selectionForegroundNormal = selGroup.readEntry("ForegroundNormal", QColor());
+
+    colors->buttonBackgroundNormal = buttonGroup.readEntry("BackgroundNormal", QColor());
+    colors->buttonForegroundNormal = buttonGroup.readEntry("ForegroundNormal", QColor());
+    colors->buttonDecorationHover = buttonGroup.readEntry("DecorationHover", QColor());
+    colors->buttonDecorationFocus = buttonGroup.readEntry("DecorationFocus", QColor());
+
+    qDebug() << "scheme colors registry :: parsed" << schemeFile;
+
+    return colors;
+}
+
+}
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SCHEMESREGISTRY_H
+#define SCHEMESREGISTRY_H
+
+// Qt
+#include <QColor>
+#include <QHash>
+#include <QObject>
+#include <QSharedPointer>
+
+namespace Latte {
+namespace WindowSystem {
+
+//! immutable colors table of a color scheme file, it is shared
+//! between all the SchemeColors that are using the same file
+struct SchemeColorsTable
+{
+    QString name;
+
+    //! [WM]
+    QColor wmActiveBackground;
+    QColor wmActiveForeground;
+    QColor wmInactiveBackground;
+    QColor wmInactiveForeground;
+
+    //! [Colors:View]
+    QColor viewBackgroundNormal;
+    QColor viewBackgroundAlternate;
+    QColor viewForegroundNormal;
+    QColor viewForegroundInactive;
+    QColor viewForegroundPositive;
+    QColor viewForegroundNeutral;
+    QColor viewForegroundNegative;
+
+    //! [Colors:Selection]
+    QColor selectionBackgroundNormal;
+    QColor selectionForegroundNormal;
+
+    //! [Colors:Button]
+    QColor buttonBackgroundNormal;
+    QColor buttonForegroundNormal;
+    QColor buttonDecorationHover;
+    QColor buttonDecorationFocus;
+};
+
+//! Process-wide registry of color scheme files. Each file is parsed
+//! only once and is tracked only once for changes, afterwards its colors
+//! table is shared by all its users. Scheme names that are broadcasted
+//! by windows are also resolved to their files only once.
+class SchemesRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    static SchemesRegistry *self();
+
+    //! the colors table of schemeFile, an empty table is returned
+    //! for files that can not be found
+    QSharedPointer<const SchemeColorsTable> table(const QString &schemeFile);
+
+    //! cached SchemeColors::possibleSchemeFile(), only the "kdeglobals"
+    //! scheme is always resolved because it follows the system settings
+    QString schemeFile(const QString &scheme);
+
+    //! parses again schemeFile, it is used when a scheme file was
+    //! rewritten on purpose
+    void reload(const QString &schemeFile);
+
+signals:
+    void tableChanged(const QString &schemeFile);
+
+private slots:
+    void fileChanged(const QString &path);
+
+private:
+    SchemesRegistry(QObject *parent = nullptr);
+    ~SchemesRegistry() override;
+
+    QSharedPointer<const SchemeColorsTable> parse(const QString &schemeFile) const;
+
+private:
+    QSharedPointer<const SchemeColorsTable> m_emptyTable;
+
+    //! scheme file -> colors table
+    QHash<QString, QSharedPointer<const SchemeColorsTable>> m_tables;
+    //! scheme name -> scheme file
+    QHash<QString, QString> m_schemeFiles;
+
+    friend class SchemesRegistrySingleton;
+};
+
+}
+}
+
+#endif
@@ -36,6 +36,7 @@ License along with this library.  If not, see <http://www.gnu.org/licenses/>.
 #endif
 
 #include <QDir>
+#include <QFile>
 #include <QGuiApplication>
 #include <QRegularExpression>
 #include <QScreen>
@@ -592,6 +593,24 @@ KService::List servicesFromCmdLine(const QString &_cmdLine, const QString &proce
     return services;
 }
 
+QString commandLineFromPid(quint32 pid)
+{
+    if (pid == 0) {
+        return QString();
+    }
+
+    QFile cmdLineFile(QStringLiteral("/proc/%1/cmdline").arg(pid));
+
+    if (!cmdLineFile.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+
+    QByteArray cmdLine = cmdLineFile.readAll();
+    cmdLine.replace('\0', ' ');
+
+    return QString::fromLocal8Bit(cmdLine).trimmed();
+}
+
 QString defaultApplication(const QUrl &url)
 {
     if (url.scheme() != QLatin1String("preferred")) {
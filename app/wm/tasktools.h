@@ -132,6 +132,16 @@ KService::List servicesFromPid(quint32 pid,
 KService::List servicesFromCmdLine(const QString &cmdLine, const QString &processName,
     KSharedConfig::Ptr rulesConfig = KSharedConfig::Ptr());
 
+/**
+ * Returns the command line of a process as it is found in procfs, the
+ * arguments are separated with spaces. It is much cheaper than a full
+ * process information lookup and it is used for identification caching.
+ *
+ * @param pid A process id.
+ * @returns The process command line or an empty string.
+ */
+QString commandLineFromPid(quint32 pid);
+
 /**
  * Returns an application id for an URL using the preferred:// scheme.
  *
@@ -339,13 +339,29 @@ void LastActiveWindow::applicationDataChanged(const WindowId &wid)
 }
 
 
-void LastActiveWindow::windowChanged(const WindowId &wid)
+void LastActiveWindow::windowChanged(const WindowId &wid, WindowChanges changes)
 {
     if (!m_trackedInfo->enabled()) {
         // qDebug() << " Last Active Window, Window Changed : TrackedInfo is disabled...";
         return;
     }
 
+    if (!(changes & ~(TitleChange | IconChange))) {
+        //! title and icon changes do not affect the history, only the
+        //! displayed information of the current window is updated
+        if (m_history.count() > 0 && m_history[0] == wid) {
+            if (changes & TitleChange) {
+                setDisplay(m_windowsTracker->infoFor(wid).display());
+            }
+
+            if (changes & IconChange) {
+                setIcon(m_windowsTracker->iconFor(wid));
+            }
+        }
+
+        return;
+    }
+
     if (m_history.contains(wid)) {
         //! remove from history minimized windows or windows that changed screen
         //! and update information accordingly with the first valid window found from
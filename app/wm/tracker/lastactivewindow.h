@@ -106,7 +106,7 @@ public slots:
 private slots:
     void applicationDataChanged(const WindowId &wid);
 
-    void windowChanged(const WindowId &wid);
+    void windowChanged(const WindowId &wid, WindowChanges changes = AllChanges);
     void windowRemoved(const WindowId &wid);
 
 
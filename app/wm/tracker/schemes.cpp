@@ -21,6 +21,8 @@
 
 // local
 #include "../abstractwindowinterface.h"
+#include "../schemecolors.h"
+#include "../schemesregistry.h"
 #include "../../lattecorona.h"
 
 // Qt
@@ -125,7 +127,8 @@ void Schemes::setColorSchemeForWindow(WindowId wid, QString scheme)
         //! a window that previously had an explicit set scheme now is set back to default scheme
         m_windowScheme.remove(wid);
     } else {
-        QString schemeFile = SchemeColors::possibleSchemeFile(scheme);
+        //! scheme names are resolved only once, apps may broadcast them often
+        QString schemeFile = SchemesRegistry::self()->schemeFile(scheme);
 
         if (!m_schemes.contains(schemeFile)) {
             //! when this scheme file has not been loaded yet
@@ -37,6 +37,9 @@ namespace Latte {
 namespace WindowSystem {
 namespace Tracker {
 
+//! window changes that can affect views and layouts hints
+const WindowChanges HINTSCHANGES = GeometryChange | StateChange | DesktopChange | ActivityChange;
+
 Windows::Windows(AbstractWindowInterface *parent)
     : QObject(parent)
 {
@@ -52,6 +55,12 @@ Windows::Windows(AbstractWindowInterface *parent)
     m_updateApplicationDataTimer.setSingleShot(true);
     connect(&m_updateApplicationDataTimer, &QTimer::timeout, this, &Windows::updateApplicationData);
 
+    //! windows snapshot
+    m_snapshot = std::make_shared<const WindowsSnapshot>();
+    m_snapshotTimer.setInterval(0);
+    m_snapshotTimer.setSingleShot(true);
+    connect(&m_snapshotTimer, &QTimer::timeout, this, &Windows::publishSnapshot);
+
     init();
 }
 
@@ -78,19 +87,19 @@ void Windows::init()
 {
     connect(m_wm->corona(), &Plasma::Corona::availableScreenRectChanged, this, &Windows::updateAvailableScreenGeometries);
 
-    connect(m_wm, &AbstractWindowInterface::windowChanged, this, [&](WindowId wid) {
-        m_windows[wid] = m_wm->requestInfo(wid);
-        updateAllHints();
-
-        emit windowChanged(wid);
+    connect(m_wm, &AbstractWindowInterface::windowChanged, this, [&](WindowId wid, WindowChanges changes) {
+        updateWindows({{wid, changes}});
     });
 
+    connect(m_wm, &AbstractWindowInterface::windowsChanged, this, &Windows::updateWindows);
+
     connect(m_wm, &AbstractWindowInterface::windowRemoved, this, [&](WindowId wid) {
         m_windows.remove(wid);
+        scheduleSnapshot();
 
         //! application data
-        m_initializedApplicationData.removeAll(wid);
-        m_delayedApplicationData.removeAll(wid);
+        m_initializedApplicationData.remove(wid);
+        m_delayedApplicationData.remove(wid);
 
         updateAllHints();
 
@@ -100,6 +109,7 @@ void Windows::init()
     connect(m_wm, &AbstractWindowInterface::windowAdded, this, [&](WindowId wid) {
         if (!m_windows.contains(wid)) {
             m_windows.insert(wid, m_wm->requestInfo(wid));
+            scheduleSnapshot();
         }
         updateAllHints();
     });
@@ -115,6 +125,7 @@ void Windows::init()
         }
 
         m_windows[wid] = m_wm->requestInfo(wid);
+        scheduleSnapshot();
         updateAllHints();
 
         emit activeWindowChanged(wid);
@@ -135,6 +146,42 @@ void Windows::init()
     });
 }
 
+void Windows::updateWindows(const WindowChangesBatch &changes)
+{
+    bool hintsChanged{false};
+
+    for (auto i = changes.constBegin(); i != changes.constEnd(); ++i) {
+        const WindowId wid = i.key();
+
+        if ((i.value() & HINTSCHANGES) || !m_windows.contains(wid)) {
+            m_windows[wid] = m_wm->requestInfo(wid);
+            hintsChanged = true;
+        } else {
+            //! title and icon changes do not affect any hints, the already
+            //! identified application data of the window are also preserved
+            if (i.value() & TitleChange) {
+                m_windows[wid].setDisplay(m_wm->titleFor(wid));
+            }
+
+            if (i.value() & IconChange) {
+                //! it is requested again through iconFor()
+                m_windows[wid].setIcon(QIcon());
+            }
+        }
+    }
+
+    scheduleSnapshot();
+
+    //! hints are updated only once for the entire batch
+    if (hintsChanged) {
+        updateAllHints();
+    }
+
+    for (auto i = changes.constBegin(); i != changes.constEnd(); ++i) {
+        emit windowChanged(i.key(), i.value());
+    }
+}
+
 void Windows::initLayoutHints(Latte::Layout::GenericLayout *layout)
 {
     if (!m_layouts.contains(layout)) {
@@ -587,6 +634,7 @@ QIcon Windows::iconFor(const WindowId &wid)
         }
 
         m_windows[wid].setIcon(icon);
+        scheduleSnapshot();
         return icon;
     }
 
@@ -600,7 +648,7 @@ QString Windows::appNameFor(const WindowId &wid)
     }
 
     if(!m_initializedApplicationData.contains(wid) && !m_delayedApplicationData.contains(wid)) {
-        m_delayedApplicationData.append(wid);
+        m_delayedApplicationData.insert(wid);
         m_updateApplicationDataTimer.start();
     }
 
@@ -608,6 +656,7 @@ QString Windows::appNameFor(const WindowId &wid)
         AppData data = m_wm->appDataFor(wid);
 
         m_windows[wid].setAppName(data.name);
+        scheduleSnapshot();
 
         return data.name;
     }
@@ -617,30 +666,29 @@ QString Windows::appNameFor(const WindowId &wid)
 
 void Windows::updateApplicationData()
 {
-    if (m_delayedApplicationData.count() > 0) {
-        for(int i=0; i<m_delayedApplicationData.count(); ++i) {
-            auto wid = m_delayedApplicationData[i];
+    //! windows that are delayed while the current ones are updated are handled next time
+    const QList<WindowId> delayed = m_delayedApplicationData.windows();
+    m_delayedApplicationData.clear();
 
-            if (m_windows.contains(wid)) {
-                AppData data = m_wm->appDataFor(wid);
+    for (const auto &wid : delayed) {
+        if (m_windows.contains(wid)) {
+            AppData data = m_wm->appDataFor(wid);
 
-                QIcon icon = data.icon;
+            QIcon icon = data.icon;
 
-                if (icon.isNull()) {
-                    icon = m_wm->iconFor(wid);
-                }
+            if (icon.isNull()) {
+                icon = m_wm->iconFor(wid);
+            }
 
-                m_windows[wid].setIcon(icon);
-                m_windows[wid].setAppName(data.name);
+            m_windows[wid].setIcon(icon);
+            m_windows[wid].setAppName(data.name);
+            scheduleSnapshot();
 
-                m_initializedApplicationData.append(wid);
+            m_initializedApplicationData.insert(wid);
 
-                emit applicationDataChanged(wid);
-            }
+            emit applicationDataChanged(wid);
         }
     }
-
-    m_delayedApplicationData.clear();
 }
 
 WindowInfoWrap Windows::infoFor(const WindowId &wid) const
@@ -652,6 +700,30 @@ WindowInfoWrap Windows::infoFor(const WindowId &wid) const
     return m_windows[wid];
 }
 
+WindowsSnapshotPtr Windows::snapshot() const
+{
+    return std::atomic_load(&m_snapshot);
+}
+
+void Windows::scheduleSnapshot()
+{
+    if (!m_snapshotTimer.isActive()) {
+        m_snapshotTimer.start();
+    }
+}
+
+void Windows::publishSnapshot()
+{
+    auto published = std::make_shared<WindowsSnapshot>();
+    published->version = ++m_snapshotVersion;
+    published->windows = m_windows;
+
+    //! readers that still hold the previous snapshot keep it alive until they release it
+    std::atomic_store(&m_snapshot, WindowsSnapshotPtr(published));
+
+    emit snapshotPublished(published->version);
+}
+
 
 
 //! Windows Criteria Functions
@@ -755,6 +827,7 @@ void Windows::cleanupFaultyWindows()
         if (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0)) {
             //qDebug() << "Faulty Geometry ::: " << winfo.wid();
             m_windows.remove(key);
+            scheduleSnapshot();
         }
     }
 }
@@ -784,6 +857,7 @@ void Windows::setPlasmaDesktop(WindowId wid)
 
     if (!m_windows[wid].isPlasmaDesktop()) {
         m_windows[wid].setIsPlasmaDesktop(true);
+        scheduleSnapshot();
         qDebug() << " plasmashell updated...";
         updateAllHints();
     }
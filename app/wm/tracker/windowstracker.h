@@ -22,6 +22,7 @@
 
 // local
 #include "../windowinfowrap.h"
+#include "../windowsindex.h"
 
 // Qt
 #include <QObject>
@@ -30,6 +31,9 @@
 #include <QMap>
 #include <QTimer>
 
+// C++
+#include <memory>
+
 namespace Latte {
 class View;
 namespace Layout {
@@ -50,6 +54,26 @@ namespace Latte {
 namespace WindowSystem {
 namespace Tracker {
 
+//! Immutable copy of the tracked windows. A new snapshot is published after each
+//! batch of window updates and it is never modified afterwards, so threads other
+//! than the GUI one can read it without locks. Icons are shared QIcon copies and
+//! should only be rendered from the GUI thread.
+struct WindowsSnapshot {
+    quint64 version{0};
+    QMap<WindowId, WindowInfoWrap> windows;
+
+    bool isValidFor(const WindowId &wid) const {
+        auto winfo = windows.constFind(wid);
+        return (winfo != windows.constEnd() && winfo->isValid() && !winfo->isPlasmaDesktop());
+    }
+
+    WindowInfoWrap infoFor(const WindowId &wid) const {
+        return windows.value(wid, WindowInfoWrap());
+    }
+};
+
+using WindowsSnapshotPtr = std::shared_ptr<const WindowsSnapshot>;
+
 class Windows : public QObject {
     Q_OBJECT
 
@@ -88,6 +112,9 @@ public:
     QString appNameFor(const WindowId &wid);
     WindowInfoWrap infoFor(const WindowId &wid) const;
 
+    //! thread-safe, returns the last published snapshot of the tracked windows
+    WindowsSnapshotPtr snapshot() const;
+
     void setPlasmaDesktop(WindowId wid);
 
     AbstractWindowInterface *wm();
@@ -116,11 +143,13 @@ signals:
     //! overloading WM signals in order to update first m_windows and afterwards
     //! inform consumers for window changes
     void activeWindowChanged(const WindowId &wid);
-    void windowChanged(const WindowId &wid);
+    void windowChanged(const WindowId &wid, WindowChanges changes = AllChanges);
     void windowRemoved(const WindowId &wid);
 
     void applicationDataChanged(const WindowId &wid);
 
+    void snapshotPublished(quint64 version);
+
 private slots:
     void updateAvailableScreenGeometries();
 
@@ -130,11 +159,15 @@ private slots:
     void updateRelevantLayouts();
     void updateExtraViewHints();
 
+    void publishSnapshot();
+    void updateWindows(const Latte::WindowSystem::WindowChangesBatch &changes);
+
 private:
     void init();
     void initLayoutHints(Latte::Layout::GenericLayout *layout);
     void initViewHints(Latte::View *view);
     void cleanupFaultyWindows();
+    void scheduleSnapshot();
 
     void updateAllHints();
 
@@ -180,8 +213,14 @@ private:
     //! such as Libreoffice that updates its StartupWMClass after
     //! its startup
     QTimer m_updateApplicationDataTimer;
-    QList<WindowId> m_delayedApplicationData;
-    QList<WindowId> m_initializedApplicationData;
+    WindowIdSet m_delayedApplicationData;
+    WindowIdSet m_initializedApplicationData;
+
+    //! m_windows changes of the same event loop pass are published together,
+    //! the snapshot is only swapped atomically and never written in place
+    QTimer m_snapshotTimer;
+    quint64 m_snapshotVersion{0};
+    WindowsSnapshotPtr m_snapshot;
 };
 
 }
@@ -21,6 +21,7 @@
 #include "waylandinterface.h"
 
 // local
+#include "appdatacache.h"
 #include "view/screenedgeghostwindow.h"
 #include "view/view.h"
 #include "../lattecorona.h"
@@ -150,7 +151,7 @@ void WaylandInterface::initWindowManagement(KWayland::Client::PlasmaWindowManage
     connect(m_windowManagement, &PlasmaWindowManagement::windowCreated, this, &WaylandInterface::windowCreatedProxy);
     connect(m_windowManagement, &PlasmaWindowManagement::activeWindowChanged, this, [&]() noexcept {
                 auto w = m_windowManagement->activeWindow();
-                if (!w || (w && (!m_ignoredWindows.contains(w->internalId() && !isPlasmaDesktop(w)))) ) {
+                if (!w || (!m_ignoredWindows.contains(w->internalId()) && !isPlasmaDesktop(w))) {
                     emit activeWindowChanged(w ? w->internalId() : 0);
                 }
 
@@ -221,9 +222,7 @@ KWayland::Client::PlasmaShell *WaylandInterface::waylandCoronaInterface() const
 //! Register Latte Ignored Windows in order to NOT be tracked
 void WaylandInterface::registerIgnoredWindow(WindowId wid)
 {
-    if (!wid.isNull() && !m_ignoredWindows.contains(wid)) {
-        m_ignoredWindows.append(wid);
-
+    if (!wid.isNull() && m_ignoredWindows.insert(wid)) {
         KWayland::Client::PlasmaWindow *w = windowFor(wid);
 
         if (w) {
@@ -236,8 +235,7 @@ void WaylandInterface::registerIgnoredWindow(WindowId wid)
 
 void WaylandInterface::unregisterIgnoredWindow(WindowId wid)
 {
-    if (m_ignoredWindows.contains(wid)) {
-        m_ignoredWindows.removeAll(wid);
+    if (m_ignoredWindows.remove(wid)) {
         emit windowRemoved(wid);
     }
 }
@@ -462,8 +460,20 @@ AppData WaylandInterface::appDataFor(WindowId wid) const
 {
     auto window = windowFor(wid);
 
-    const AppData &data = appDataFromUrl(windowUrlFromMetadata(window->appId(),
-                                                               window->pid(), rulesConfig));
+    if (!window) {
+        return AppData();
+    }
+
+    const QString key = AppDataCache::key(window->appId(), QString(), commandLineFromPid(window->pid()));
+
+    AppData data;
+
+    if (appDataCache()->find(key, data)) {
+        return data;
+    }
+
+    data = appDataFromUrl(windowUrlFromMetadata(window->appId(), window->pid(), rulesConfig));
+    appDataCache()->insert(key, data);
 
     return data;
 }
@@ -493,6 +503,13 @@ QIcon WaylandInterface::iconFor(WindowId wid) const
     return QIcon();
 }
 
+QString WaylandInterface::titleFor(WindowId wid) const
+{
+    auto window = windowFor(wid);
+
+    return window ? window->title() : QString();
+}
+
 WindowId WaylandInterface::winIdFor(QString appId, QRect geometry) const
 {
     auto it = std::find_if(m_windowManagement->windows().constBegin(), m_windowManagement->windows().constEnd(), [&appId, &geometry](PlasmaWindow * w) noexcept {
@@ -659,20 +676,14 @@ bool WaylandInterface::isValidWindow(const KWayland::Client::PlasmaWindow *w) co
     return w->isValid() && !isPlasmaDesktop(w) && !m_plasmaPanels.contains(w->internalId()) && !m_ignoredWindows.contains(w->internalId());
 }
 
-void WaylandInterface::updateWindow()
+void WaylandInterface::updateWindow(KWayland::Client::PlasmaWindow *w, WindowChanges changes)
 {
-    PlasmaWindow *pW = qobject_cast<PlasmaWindow*>(QObject::sender());
-
-    if (pW && !m_ignoredWindows.contains(pW->internalId() && !isPlasmaDesktop(pW) )) {
-        if (pW->appId() == QLatin1String("org.kde.plasmashell")) {
-            if (isPlasmaDesktop(pW)) {
-                return;
-            } else if (isPlasmaPanel(pW)) {
-                registerIgnoredWindow(pW->internalId());
-            }
+    if (w && !m_ignoredWindows.contains(w->internalId()) && !isPlasmaDesktop(w)) {
+        if (w->appId() == QLatin1String("org.kde.plasmashell") && isPlasmaPanel(w)) {
+            registerIgnoredWindow(w->internalId());
         }
 
-        considerWindowChanged(pW->internalId());
+        considerWindowChanged(w->internalId(), changes);
     }
 }
 
@@ -692,22 +703,31 @@ void WaylandInterface::trackWindow(KWayland::Client::PlasmaWindow *w)
         return;
     }
 
-    connect(w, &PlasmaWindow::activeChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::titleChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::fullscreenChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::geometryChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::maximizedChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::minimizedChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::shadedChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::skipTaskbarChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::onAllDesktopsChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::parentWindowChanged, this, &WaylandInterface::updateWindow);
+    //! each PlasmaWindow signal carries only the properties it affects, this way
+    //! consumers do not need to recompute everything e.g. for title-only changes
+    auto changed = [this, w](WindowChanges changes) {
+        return [this, w, changes]() {
+            updateWindow(w, changes);
+        };
+    };
+
+    connect(w, &PlasmaWindow::activeChanged, this, changed(StateChange));
+    connect(w, &PlasmaWindow::titleChanged, this, changed(TitleChange));
+    connect(w, &PlasmaWindow::iconChanged, this, changed(IconChange));
+    connect(w, &PlasmaWindow::fullscreenChanged, this, changed(StateChange));
+    connect(w, &PlasmaWindow::geometryChanged, this, changed(GeometryChange));
+    connect(w, &PlasmaWindow::maximizedChanged, this, changed(StateChange));
+    connect(w, &PlasmaWindow::minimizedChanged, this, changed(StateChange));
+    connect(w, &PlasmaWindow::shadedChanged, this, changed(StateChange));
+    connect(w, &PlasmaWindow::skipTaskbarChanged, this, changed(StateChange));
+    connect(w, &PlasmaWindow::onAllDesktopsChanged, this, changed(DesktopChange));
+    connect(w, &PlasmaWindow::parentWindowChanged, this, changed(StateChange));
 
 #if KF5_VERSION_MINOR >= 52
-    connect(w, &PlasmaWindow::plasmaVirtualDesktopEntered, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::plasmaVirtualDesktopLeft, this, &WaylandInterface::updateWindow);
+    connect(w, &PlasmaWindow::plasmaVirtualDesktopEntered, this, changed(DesktopChange));
+    connect(w, &PlasmaWindow::plasmaVirtualDesktopLeft, this, changed(DesktopChange));
 #else
-    connect(w, &PlasmaWindow::virtualDesktopChanged, this, &WaylandInterface::updateWindow);
+    connect(w, &PlasmaWindow::virtualDesktopChanged, this, changed(DesktopChange));
 #endif
 
     connect(w, &PlasmaWindow::unmapped, this, &WaylandInterface::windowUnmapped);
@@ -719,25 +739,8 @@ void WaylandInterface::untrackWindow(KWayland::Client::PlasmaWindow *w)
         return;
     }
 
-    disconnect(w, &PlasmaWindow::activeChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::titleChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::fullscreenChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::geometryChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::maximizedChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::minimizedChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::shadedChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::skipTaskbarChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::onAllDesktopsChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::parentWindowChanged, this, &WaylandInterface::updateWindow);
-
-#if KF5_VERSION_MINOR >= 52
-    disconnect(w, &PlasmaWindow::plasmaVirtualDesktopEntered, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::plasmaVirtualDesktopLeft, this, &WaylandInterface::updateWindow);
-#else
-    disconnect(w, &PlasmaWindow::virtualDesktopChanged, this, &WaylandInterface::updateWindow);
-#endif
-
-    disconnect(w, &PlasmaWindow::unmapped, this, &WaylandInterface::windowUnmapped);
+    //! all window connections are owned by trackWindow()
+    disconnect(w, nullptr, this, nullptr);
 }
 
 
@@ -87,6 +87,7 @@ public:
     bool windowCanBeMaximized(WindowId wid) const override;
 
     QIcon iconFor(WindowId wid) const;
+    QString titleFor(WindowId wid) const;
     WindowId winIdFor(QString appId, QRect geometry) const override;
     AppData appDataFor(WindowId wid) const override;
 
@@ -106,7 +107,6 @@ public:
 #endif
 
 private slots:
-    void updateWindow();
     void windowUnmapped();
 
 private:
@@ -117,6 +117,7 @@ private:
     void windowCreatedProxy(KWayland::Client::PlasmaWindow *w);
     void trackWindow(KWayland::Client::PlasmaWindow *w);
     void untrackWindow(KWayland::Client::PlasmaWindow *w);
+    void updateWindow(KWayland::Client::PlasmaWindow *w, WindowChanges changes);
 
     KWayland::Client::PlasmaWindow *windowFor(WindowId wid) const;
     KWayland::Client::PlasmaShell *waylandCoronaInterface() const;
@@ -22,8 +22,10 @@
 #define WINDOWINFOWRAP_H
 
 // Qt
+#include <QFlags>
 #include <QWindow>
 #include <QIcon>
+#include <QMap>
 #include <QRect>
 #include <QVariant>
 
@@ -32,6 +34,23 @@ namespace WindowSystem {
 
 using WindowId = QVariant;
 
+//! window properties that changed, they are sent together with each window change
+//! in order for the consumers to recompute only what is really affected
+enum WindowChange {
+    NoChange = 0x00,
+    GeometryChange = 0x01,
+    StateChange = 0x02,
+    DesktopChange = 0x04,
+    ActivityChange = 0x08,
+    TitleChange = 0x10,
+    IconChange = 0x20,
+    AllChanges = GeometryChange | StateChange | DesktopChange | ActivityChange | TitleChange | IconChange
+};
+Q_DECLARE_FLAGS(WindowChanges, WindowChange)
+
+//! windows that changed together with their accumulated changes
+using WindowChangesBatch = QMap<WindowId, WindowChanges>;
+
 class WindowInfoWrap
 {
 
@@ -492,4 +511,6 @@ inline bool WindowInfoWrap::isOnActivity(const QString &activity) const noexcept
 }
 }
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(Latte::WindowSystem::WindowChanges)
+
 #endif // WINDOWINFOWRAP_H
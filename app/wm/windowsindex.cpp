@@ -0,0 +1,214 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "windowsindex.h"
+
+// Qt
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QScreen>
+
+namespace Latte {
+namespace WindowSystem {
+
+namespace {
+bool s_metricsEnabled{false};
+quint64 s_lookups{0};
+quint64 s_lookupsNsecs{0};
+
+//! counts every index lookup and measures it only when metrics are enabled
+class LookupTimer
+{
+public:
+    LookupTimer() {
+        ++s_lookups;
+
+        if (s_metricsEnabled) {
+            m_timer.start();
+        }
+    }
+
+    ~LookupTimer() {
+        if (s_metricsEnabled && m_timer.isValid()) {
+            s_lookupsNsecs += m_timer.nsecsElapsed();
+        }
+    }
+
+private:
+    QElapsedTimer m_timer;
+};
+}
+
+//! WindowIdSet
+quint64 WindowIdSet::nativeId(const WindowId &wid)
+{
+    //! x11 window ids and wayland internal ids are both unsigned integers
+    return wid.toULongLong();
+}
+
+bool WindowIdSet::contains(const WindowId &wid) const
+{
+    LookupTimer timer;
+    return m_windows.contains(nativeId(wid));
+}
+
+bool WindowIdSet::isEmpty() const
+{
+    return m_windows.isEmpty();
+}
+
+int WindowIdSet::count() const
+{
+    return m_windows.count();
+}
+
+bool WindowIdSet::insert(const WindowId &wid)
+{
+    const quint64 id = nativeId(wid);
+
+    if (m_windows.contains(id)) {
+        return false;
+    }
+
+    m_windows[id] = wid;
+    return true;
+}
+
+bool WindowIdSet::remove(const WindowId &wid)
+{
+    return (m_windows.remove(nativeId(wid)) > 0);
+}
+
+void WindowIdSet::clear()
+{
+    m_windows.clear();
+}
+
+QList<WindowId> WindowIdSet::windows() const
+{
+    return m_windows.values();
+}
+
+//! ScreenEdgesTable
+ScreenEdgesTable::ScreenEdgesTable(QObject *parent)
+    : QObject(parent)
+{
+    connect(qGuiApp, &QGuiApplication::screenAdded, this, [&](QScreen *screen) {
+        connect(screen, &QScreen::geometryChanged, this, &ScreenEdgesTable::rebuild);
+        rebuild();
+    });
+    connect(qGuiApp, &QGuiApplication::screenRemoved, this, &ScreenEdgesTable::rebuild);
+
+    for (const auto scr : qGuiApp->screens()) {
+        connect(scr, &QScreen::geometryChanged, this, &ScreenEdgesTable::rebuild);
+    }
+
+    rebuild();
+}
+
+ScreenEdgesTable::~ScreenEdgesTable()
+{
+}
+
+void ScreenEdgesTable::rebuild()
+{
+    m_screens.clear();
+
+    for (const auto scr : qGuiApp->screens()) {
+        m_screens << scr->geometry();
+    }
+}
+
+bool ScreenEdgesTable::isScreenGeometry(const QRect &geometry) const
+{
+    LookupTimer timer;
+
+    if (geometry.isEmpty()) {
+        return false;
+    }
+
+    for (const auto &scrGeometry : m_screens) {
+        if (geometry == scrGeometry) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ScreenEdgesTable::isEdgeGeometry(const QRect &geometry, int maxThickness) const
+{
+    LookupTimer timer;
+
+    if (geometry.isEmpty()) {
+        return false;
+    }
+
+    bool isTouchingHorizontalEdge{false};
+    bool isTouchingVerticalEdge{false};
+
+    for (const auto &scrGeometry : m_screens) {
+        if (scrGeometry.contains(geometry.center())) {
+            if (geometry.y() == scrGeometry.y() || geometry.bottom() == scrGeometry.bottom()) {
+                isTouchingHorizontalEdge = true;
+            }
+
+            if (geometry.left() == scrGeometry.left() || geometry.right() == scrGeometry.right()) {
+                isTouchingVerticalEdge = true;
+            }
+
+            if (isTouchingVerticalEdge && isTouchingHorizontalEdge) {
+                break;
+            }
+        }
+    }
+
+    return ((isTouchingHorizontalEdge && geometry.height() < maxThickness)
+            || (isTouchingVerticalEdge && geometry.width() < maxThickness));
+}
+
+//! WindowsIndexMetrics
+bool WindowsIndexMetrics::enabled()
+{
+    return s_metricsEnabled;
+}
+
+void WindowsIndexMetrics::setEnabled(bool enabled)
+{
+    s_metricsEnabled = enabled;
+}
+
+quint64 WindowsIndexMetrics::lookups()
+{
+    return s_lookups;
+}
+
+quint64 WindowsIndexMetrics::lookupsNsecs()
+{
+    return s_lookupsNsecs;
+}
+
+void WindowsIndexMetrics::reset()
+{
+    s_lookups = 0;
+    s_lookupsNsecs = 0;
+}
+
+}
+}
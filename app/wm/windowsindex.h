@@ -0,0 +1,100 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSINDEX_H
+#define WINDOWSINDEX_H
+
+// local
+#include "windowinfowrap.h"
+
+// Qt
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QRect>
+#include <QVector>
+
+namespace Latte {
+namespace WindowSystem {
+
+//! Hashed set of windows keyed by their native window ids, it is used
+//! to classify windows e.g. ignored windows and plasma panels
+class WindowIdSet
+{
+public:
+    bool contains(const WindowId &wid) const;
+    bool isEmpty() const;
+    int count() const;
+
+    //! returns true when the set changed
+    bool insert(const WindowId &wid);
+    bool remove(const WindowId &wid);
+    void clear();
+
+    QList<WindowId> windows() const;
+
+private:
+    static quint64 nativeId(const WindowId &wid);
+
+private:
+    QHash<quint64, WindowId> m_windows;
+};
+
+//! Screen geometries table that is updated only when screens change,
+//! windows geometries are classified against it without querying
+//! the screens for every window event
+class ScreenEdgesTable : public QObject
+{
+    Q_OBJECT
+
+public:
+    ScreenEdgesTable(QObject *parent = nullptr);
+    ~ScreenEdgesTable() override;
+
+    //! geometry covers exactly a screen
+    bool isScreenGeometry(const QRect &geometry) const;
+    //! geometry is touching a screen edge and is thinner than maxThickness
+    bool isEdgeGeometry(const QRect &geometry, int maxThickness) const;
+
+private slots:
+    void rebuild();
+
+private:
+    QVector<QRect> m_screens;
+};
+
+//! Lookups cost instrumentation of the windows classification index. Lookups
+//! are always counted, their timing is disabled by default because timing
+//! each lookup costs more than the lookup.
+class WindowsIndexMetrics
+{
+public:
+    static bool enabled();
+    static void setEnabled(bool enabled);
+
+    static quint64 lookups();
+    static quint64 lookupsNsecs();
+
+    static void reset();
+};
+
+}
+}
+
+#endif
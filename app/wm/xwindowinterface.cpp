@@ -21,6 +21,7 @@
 #include "xwindowinterface.h"
 
 // local
+#include "appdatacache.h"
 #include "tasktools.h"
 #include "view/screenedgeghostwindow.h"
 #include "view/view.h"
@@ -361,7 +362,23 @@ WindowInfoWrap XWindowInterface::requestInfo(WindowId wid) const
 
 AppData XWindowInterface::appDataFor(WindowId wid) const
 {
-    return appDataFromUrl(windowUrl(wid));
+    const KWindowInfo info(wid.value<WId>(), 0, NET::WM2WindowClass | NET::WM2DesktopFileName);
+    const quint32 pid = NETWinInfo(QX11Info::connection(), wid.value<WId>(), QX11Info::appRootWindow(), NET::WMPid, NET::Properties2()).pid();
+
+    const QString key = AppDataCache::key(QString::fromUtf8(info.windowClassClass() + '/' + info.windowClassName()),
+                                          QString::fromUtf8(info.desktopFileName()),
+                                          commandLineFromPid(pid));
+
+    AppData data;
+
+    if (appDataCache()->find(key, data)) {
+        return data;
+    }
+
+    data = appDataFromUrl(windowUrl(wid));
+    appDataCache()->insert(key, data);
+
+    return data;
 }
 
 QUrl XWindowInterface::windowUrl(WindowId wid) const
@@ -449,6 +466,13 @@ QIcon XWindowInterface::iconFor(WindowId wid) const
     return icon;
 }
 
+QString XWindowInterface::titleFor(WindowId wid) const
+{
+    const KWindowInfo winfo{wid.value<WId>(), NET::WMName | NET::WMVisibleName};
+
+    return winfo.valid() ? winfo.visibleName() : QString();
+}
+
 WindowId XWindowInterface::winIdFor(QString appId, QRect geometry) const
 {
     return activeWindow();
@@ -658,11 +682,12 @@ void XWindowInterface::windowChangedProxy(WId wid, NET::Properties prop1, NET::P
     }
 
     //! accept only the following NET:Properties changed signals
-    //! NET::WMState, NET::WMGeometry, NET::ActiveWindow
+    //! NET::WMState, NET::WMGeometry, NET::ActiveWindow, NET::WMIcon
     if ( !(prop1 & NET::WMState)
          && !(prop1 & NET::WMGeometry)
          && !(prop1 & NET::ActiveWindow)
          && !(prop1 & NET::WMDesktop)
+         && !(prop1 & NET::WMIcon)
          && !(prop1 & (NET::WMName | NET::WMVisibleName)
               && !(prop2 & NET::WM2TransientFor)
               && !(prop2 & NET::WM2Activities)) ) {
@@ -674,7 +699,33 @@ void XWindowInterface::windowChangedProxy(WId wid, NET::Properties prop1, NET::P
         return;
     }
 
-    considerWindowChanged(wid);
+    WindowChanges changes{NoChange};
+
+    if (prop1 & NET::WMGeometry) {
+        changes |= GeometryChange;
+    }
+
+    if ((prop1 & (NET::WMState | NET::ActiveWindow)) || (prop2 & NET::WM2TransientFor)) {
+        changes |= StateChange;
+    }
+
+    if (prop1 & NET::WMDesktop) {
+        changes |= DesktopChange;
+    }
+
+    if (prop2 & NET::WM2Activities) {
+        changes |= ActivityChange;
+    }
+
+    if (prop1 & (NET::WMName | NET::WMVisibleName)) {
+        changes |= TitleChange;
+    }
+
+    if (prop1 & NET::WMIcon) {
+        changes |= IconChange;
+    }
+
+    considerWindowChanged(wid, changes == NoChange ? WindowChanges(AllChanges) : changes);
 }
 
 }
@@ -72,6 +72,7 @@ public:
     bool windowCanBeMaximized(WindowId wid) const override;
 
     QIcon iconFor(WindowId wid) const override;
+    QString titleFor(WindowId wid) const override;
     WindowId winIdFor(QString appId, QRect geometry) const override;   
     AppData appDataFor(WindowId wid) const override;
 
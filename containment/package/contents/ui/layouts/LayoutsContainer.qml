@@ -269,8 +269,8 @@ Item{
         }
     }
 
-    //! This timer is needed in order to reduce the calls to heavy cpu function
-    //! HeuristicTools.updateSizeForAppletsInFill()
+    //! This timer is needed in order to batch the fill applets size updates
+    //! from HeuristicTools.updateSizeForAppletsInFill()
     Timer{
         id: updateSizeForAppletsInFillTimer
         interval: 10
@@ -994,34 +994,6 @@ Item {
         }
     }
 
-    //! it is used in order to check the right click position
-    //! the only way to take into account the visual appearance
-    //! of the applet (including its spacers)
-    function appletContainsPos(appletId, pos){
-        for (var i = 0; i < layoutsContainer.startLayout.children.length; ++i) {
-            var child = layoutsContainer.startLayout.children[i];
-
-            if (child && child.applet && child.applet.id === appletId && child.containsPos(pos))
-                return true;
-        }
-
-        for (var i = 0; i < layoutsContainer.mainLayout.children.length; ++i) {
-            var child = layoutsContainer.mainLayout.children[i];
-
-            if (child && child.applet && child.applet.id === appletId && child.containsPos(pos))
-                return true;
-        }
-
-        for (var i = 0; i < layoutsContainer.endLayout.children.length; ++i) {
-            var child = layoutsContainer.endLayout.children[i];
-
-            if (child && child.applet && child.applet.id === appletId && child.containsPos(pos))
-                return true;
-        }
-
-        return false;
-    }
-
     function checkLastSpacer() {
         lastSpacer.parent = root
 
@@ -0,0 +1,293 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "filllayoutsolver.h"
+
+// C++
+#include <cmath>
+
+namespace Latte {
+
+namespace {
+//! qBound style function that is specialized in Layouts
+//! meaning that -1 values are ignored for fillWidth(s)/Height(s)
+qreal layoutBound(qreal min, qreal pref, qreal max)
+{
+    if (max == -1) {
+        max = (pref == -1) ? min : pref;
+    }
+
+    if (pref == -1) {
+        pref = (max == -1) ? min : pref;
+    }
+
+    return qMin(qMax(min, pref), max);
+}
+
+//! values are stored as the integer sizeForFill property of AppletItem
+int toSize(qreal value)
+{
+    return static_cast<int>(value);
+}
+}
+
+FillLayoutSolver::FillLayoutSolver(QObject *parent)
+    : QObject(parent)
+{
+}
+
+FillLayoutSolver::~FillLayoutSolver()
+{
+}
+
+FillLayoutSolver::Layout FillLayoutSolver::layoutFromMetrics(const QVariantList &metrics) const
+{
+    Layout layout;
+    layout.reserve(metrics.count());
+
+    for (const auto &appletMetrics : metrics) {
+        const QVariantList values = appletMetrics.toList();
+        Applet applet;
+
+        if (values.count() >= 5) {
+            applet.minimum = values[0].toReal();
+            applet.preferred = values[1].toReal();
+            applet.maximum = values[2].toReal();
+            applet.isHidden = values[3].toBool();
+            applet.size = values[4].toInt();
+        }
+
+        layout << applet;
+    }
+
+    return layout;
+}
+
+QVariantList FillLayoutSolver::sizesFromLayout(const Layout &layout) const
+{
+    QVariantList sizes;
+
+    for (const auto &applet : layout) {
+        sizes << applet.size;
+    }
+
+    return sizes;
+}
+
+void FillLayoutSolver::computeStep1(Layout &layout, qreal &availableSpace, qreal &sizePerApplet, int &noOfApplets, qreal thickness) const
+{
+    for (auto &applet : layout) {
+        qreal minSize = (applet.minimum >= 0 && !std::isinf(applet.minimum)) ? applet.minimum : -1;
+        qreal prefSize = (minSize >= 0 && !std::isinf(applet.preferred)) ? applet.preferred : -1;
+        qreal maxSize = (applet.maximum >= 0 && !std::isinf(applet.maximum)) ? applet.maximum : -1;
+
+        //! applets that do not provide any valid metrics are given their space
+        //! after the applets that provide nice metrics are assigned their sizes
+        bool systemDecide = (minSize < 0) && (prefSize < 0) && (maxSize < 0);
+
+        if (systemDecide) {
+            continue;
+        }
+
+        qreal appliedSize = -1;
+
+        if (noOfApplets > 1) {
+            appliedSize = layoutBound(minSize, prefSize, maxSize);
+        } else if (noOfApplets == 1) {
+            //! the last applet must not exceed the available space
+            appliedSize = layoutBound(minSize, prefSize, qMin(maxSize, sizePerApplet));
+        }
+
+        //! applets that need more than sizePerApplet are sized fairly during step2
+        if (appliedSize >= 0 && appliedSize <= sizePerApplet) {
+            qreal properSize = qMin(appliedSize, availableSpace);
+
+            applet.size = applet.isHidden ? 0 : toSize(qMax(thickness, properSize));
+            applet.inCalculations = false;
+            availableSpace = qMax(0.0, availableSpace - applet.size);
+            noOfApplets = noOfApplets - 1;
+            sizePerApplet = noOfApplets > 1 ? std::floor(availableSpace / noOfApplets) : availableSpace;
+        }
+    }
+}
+
+void FillLayoutSolver::computeStep2(Layout &layout, qreal sizePerApplet, int noOfApplets) const
+{
+    if (sizePerApplet <= 0) {
+        return;
+    }
+
+    if (noOfApplets != 0) {
+        for (auto &applet : layout) {
+            if (applet.inCalculations) {
+                applet.size = toSize(sizePerApplet);
+                applet.inCalculations = false;
+            }
+        }
+
+        return;
+    }
+
+    //! all applets have been assigned a size and there is still free space, the most
+    //! demanding applet is the one with infinite maximum size that provided valid metrics
+    //! and gained the biggest space, otherwise the space is split between neutral applets
+    int mostDemanding{-1};
+    int mostDemandingSize{0};
+    QList<int> neutralApplets;
+
+    for (int i = 0; i < layout.count(); ++i) {
+        const Applet &applet = layout[i];
+        bool isNeutral = (applet.minimum <= 0 && applet.preferred <= 0);
+
+        if (!isNeutral && std::isinf(applet.maximum) && applet.maximum > 0 && applet.size > mostDemandingSize) {
+            mostDemanding = i;
+            mostDemandingSize = applet.size;
+        } else if (isNeutral) {
+            neutralApplets << i;
+        }
+    }
+
+    if (mostDemanding >= 0) {
+        layout[mostDemanding].size = toSize(layout[mostDemanding].size + sizePerApplet);
+    } else if (!neutralApplets.isEmpty()) {
+        qreal adjustedAppletSize = sizePerApplet / neutralApplets.count();
+
+        for (const auto i : neutralApplets) {
+            layout[i].size = toSize(layout[i].size + adjustedAppletSize);
+        }
+    }
+}
+
+QVariantList FillLayoutSolver::solve(const QVariantList &startApplets,
+                                     const QVariantList &mainApplets,
+                                     const QVariantList &endApplets,
+                                     const QVariantMap &parameters) const
+{
+    Layout startLayout = layoutFromMetrics(startApplets);
+    Layout mainLayout = layoutFromMetrics(mainApplets);
+    Layout endLayout = layoutFromMetrics(endApplets);
+
+    const bool justify = parameters.value(QStringLiteral("justify"), false).toBool();
+    const qreal maxLength = parameters.value(QStringLiteral("maxLength"), 0).toReal();
+    const qreal thickness = parameters.value(QStringLiteral("thickness"), 0).toReal();
+    const qreal panelEdgeSpacing = parameters.value(QStringLiteral("panelEdgeSpacing"), 0).toReal();
+    const int mainShownApplets = parameters.value(QStringLiteral("mainShownApplets"), 0).toInt();
+    const qreal startNoFills = parameters.value(QStringLiteral("startSizeWithNoFills"), 0).toReal();
+    const qreal mainNoFills = parameters.value(QStringLiteral("mainSizeWithNoFills"), 0).toReal();
+    const qreal endNoFills = parameters.value(QStringLiteral("endSizeWithNoFills"), 0).toReal();
+
+    int noA = startLayout.count() + mainLayout.count() + endLayout.count();
+
+    if (noA == 0) {
+        return QVariantList();
+    }
+
+    if (mainShownApplets == 0 || !justify) {
+        qreal availableSpace = qMax(0.0, maxLength - startNoFills - mainNoFills - endNoFills - panelEdgeSpacing);
+        qreal sizePerApplet = availableSpace / noA;
+
+        computeStep1(mainLayout, availableSpace, sizePerApplet, noA, thickness);
+
+        if (justify) {
+            computeStep1(startLayout, availableSpace, sizePerApplet, noA, thickness);
+            computeStep1(endLayout, availableSpace, sizePerApplet, noA, thickness);
+        } else {
+            //! only the main layout takes part in calculations when not in Justify mode
+            for (auto &applet : startLayout) {
+                applet.inCalculations = false;
+            }
+
+            for (auto &applet : endLayout) {
+                applet.inCalculations = false;
+            }
+        }
+
+        //! when all applets were assigned a valid space but some space remained free,
+        //! that space is given to the first layout that contains fill applets
+        bool remainedSpace = (noA == 0 && sizePerApplet > 0);
+
+        int startNo{-1};
+        int mainNo{-1};
+        int endNo{-1};
+
+        if (remainedSpace) {
+            if (!startLayout.isEmpty()) {
+                startNo = 0;
+            } else if (!endLayout.isEmpty()) {
+                endNo = 0;
+            } else if (!mainLayout.isEmpty()) {
+                mainNo = 0;
+            }
+        }
+
+        computeStep2(startLayout, sizePerApplet, startNo);
+        computeStep2(mainLayout, sizePerApplet, mainNo);
+        computeStep2(endLayout, sizePerApplet, endNo);
+    } else {
+        //! Justify mode, the two free spaces around the centered layout
+        qreal halfMainLayout = mainNoFills / 2;
+        qreal availableSpaceStart = qMax(0.0, maxLength / 2 - startNoFills - halfMainLayout - panelEdgeSpacing / 2);
+        qreal availableSpaceEnd = qMax(0.0, maxLength / 2 - endNoFills - halfMainLayout - panelEdgeSpacing / 2);
+        qreal availableSpace = availableSpaceStart + availableSpaceEnd - mainNoFills;
+
+        qreal sizePerAppletMain = !mainLayout.isEmpty() ? availableSpace / noA : 0;
+
+        int noStart = startLayout.count();
+        int noMain = mainLayout.count();
+        int noEnd = endLayout.count();
+
+        if (!mainLayout.isEmpty()) {
+            qreal availableSpaceMain = availableSpace;
+            computeStep1(mainLayout, availableSpaceMain, sizePerAppletMain, noMain, thickness);
+
+            qreal dif = (availableSpace - availableSpaceMain) / 2;
+            availableSpaceStart = availableSpaceStart - dif;
+            availableSpaceEnd = availableSpaceEnd - dif;
+        }
+
+        qreal sizePerAppletStart = !startLayout.isEmpty() ? availableSpaceStart / noStart : 0;
+        qreal sizePerAppletEnd = !endLayout.isEmpty() ? availableSpaceEnd / noEnd : 0;
+
+        if (!startLayout.isEmpty()) {
+            computeStep1(startLayout, availableSpaceStart, sizePerAppletStart, noStart, thickness);
+        }
+
+        if (!endLayout.isEmpty()) {
+            computeStep1(endLayout, availableSpaceEnd, sizePerAppletEnd, noEnd, thickness);
+        }
+
+        if (!mainLayout.isEmpty()) {
+            computeStep2(mainLayout, sizePerAppletMain, noMain);
+        }
+
+        if (!startLayout.isEmpty()) {
+            computeStep2(startLayout, sizePerAppletStart, noStart);
+        }
+
+        if (!endLayout.isEmpty()) {
+            computeStep2(endLayout, sizePerAppletEnd, noEnd);
+        }
+    }
+
+    return QVariantList{QVariant(sizesFromLayout(startLayout)),
+                        QVariant(sizesFromLayout(mainLayout)),
+                        QVariant(sizesFromLayout(endLayout))};
+}
+
+}
@@ -0,0 +1,91 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FILLLAYOUTSOLVER_H
+#define FILLLAYOUTSOLVER_H
+
+// Qt
+#include <QObject>
+#include <QQmlEngine>
+#include <QJSEngine>
+#include <QVariant>
+#include <QVector>
+
+namespace Latte {
+
+/**
+ * @brief The FillLayoutSolver class,
+ * computes the sizes of all fillWidth/fillHeight applets of the three
+ * containment layouts (start, main, end) in one call. Each layout passes
+ * the metrics of its fill applets in order as [minimum, preferred,
+ * maximum, isHidden, currentSize] arrays and the solver returns the new
+ * sizes for the three layouts as [[start], [main], [end]].
+ */
+class FillLayoutSolver final : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FillLayoutSolver(QObject *parent = nullptr);
+    virtual ~FillLayoutSolver();
+
+public slots:
+    //! parameters: justify, maxLength, thickness, panelEdgeSpacing, mainShownApplets,
+    //! startSizeWithNoFills, mainSizeWithNoFills, endSizeWithNoFills
+    Q_INVOKABLE QVariantList solve(const QVariantList &startApplets,
+                                   const QVariantList &mainApplets,
+                                   const QVariantList &endApplets,
+                                   const QVariantMap &parameters) const;
+
+private:
+    struct Applet {
+        qreal minimum{-1};
+        qreal preferred{-1};
+        qreal maximum{-1};
+        bool isHidden{false};
+        bool inCalculations{true};
+        int size{-1};
+    };
+
+    typedef QVector<Applet> Layout;
+
+    Layout layoutFromMetrics(const QVariantList &metrics) const;
+    QVariantList sizesFromLayout(const Layout &layout) const;
+
+    //! during step1 all applets that provide valid metrics gain their space,
+    //! availableSpace, sizePerApplet and noOfApplets are updated accordingly
+    void computeStep1(Layout &layout, qreal &availableSpace, qreal &sizePerApplet, int &noOfApplets, qreal thickness) const;
+    //! during step2 all applets that remained with no size from step1 gain
+    //! the proposed size, when noOfApplets is zero the remaining space is given
+    //! to the most demanding applet or is split between the neutral ones
+    void computeStep2(Layout &layout, qreal sizePerApplet, int noOfApplets) const;
+};
+
+static QObject *filllayoutsolver_qobject_singletontype_provider(QQmlEngine *engine, QJSEngine *scriptEngine)
+{
+    Q_UNUSED(engine)
+    Q_UNUSED(scriptEngine)
+
+// NOTE: QML engine is the owner of this resource
+    return new FillLayoutSolver;
+}
+
+}
+
+#endif // FILLLAYOUTSOLVER_H
@@ -22,8 +22,11 @@
 
 // local
 #include "backgroundtracker.h"
+#include "filllayoutsolver.h"
 #include "iconitem.h"
+#include "launcherstracker.h"
 #include "quickwindowsystem.h"
+#include "thumbnailspool.h"
 #include "types.h"
 
 // Qt
@@ -35,5 +38,8 @@ void LattePlugin::registerTypes(const char *uri)
     qmlRegisterUncreatableType<Latte::Types>(uri, 0, 2, "Types", "Latte Types uncreatable");
     qmlRegisterType<Latte::BackgroundTracker>(uri, 0, 2, "BackgroundTracker");
     qmlRegisterType<Latte::IconItem>(uri, 0, 2, "IconItem");
+    qmlRegisterType<Latte::LaunchersTracker>(uri, 0, 2, "LaunchersTracker");
     qmlRegisterSingletonType<Latte::QuickWindowSystem>(uri, 0, 2, "WindowSystem", &Latte::windowsystem_qobject_singletontype_provider);
+    qmlRegisterSingletonType<Latte::FillLayoutSolver>(uri, 0, 2, "FillLayoutSolver", &Latte::filllayoutsolver_qobject_singletontype_provider);
+    qmlRegisterSingletonType<Latte::ThumbnailsPool>(uri, 0, 2, "ThumbnailsPool", &Latte::thumbnailspool_qobject_singletontype_provider);
 }
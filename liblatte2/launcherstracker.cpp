@@ -0,0 +1,498 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "launcherstracker.h"
+
+// Qt
+#include <QDebug>
+#include <QUrl>
+
+namespace Latte {
+
+namespace {
+//! launchers that are shown in all activities
+const char NULLUUID[] = "00000000-0000-0000-0000-000000000000";
+}
+
+LaunchersTracker::LaunchersTracker(QObject *parent)
+    : QObject(parent)
+{
+    m_garbageCollectorTimer.setInterval(30 * 1000);
+    m_garbageCollectorTimer.setSingleShot(true);
+    connect(&m_garbageCollectorTimer, &QTimer::timeout, this, [&]() {
+        qDebug() << " TASKS EXTENDED MANAGER Garbage Collector...";
+        qDebug() << " waiting:" << m_waitingLaunchers << " to be added:" << m_toBeAddedLaunchers
+                 << " immediate:" << m_immediateLaunchers.values() << " to be moved:" << m_toBeMovedLaunchers.keys()
+                 << " frozen:" << m_frozenTasks.keys();
+        clearTransitions();
+    });
+}
+
+LaunchersTracker::~LaunchersTracker()
+{
+}
+
+int LaunchersTracker::count() const
+{
+    return m_launchers.count();
+}
+
+int LaunchersTracker::separatorsCount() const
+{
+    return m_separatorsCount;
+}
+
+QAbstractItemModel *LaunchersTracker::tasksModel() const
+{
+    return m_tasksModel;
+}
+
+void LaunchersTracker::setTasksModel(QAbstractItemModel *model)
+{
+    if (m_tasksModel == model) {
+        return;
+    }
+
+    if (m_tasksModel) {
+        disconnect(m_tasksModel, nullptr, this, nullptr);
+    }
+
+    m_tasksModel = model;
+    m_launcherRole = -1;
+    m_launcherActivitiesMethod = QMetaMethod();
+    m_launcherActivities.clear();
+
+    if (m_tasksModel) {
+        const auto roles = m_tasksModel->roleNames();
+
+        for (auto it = roles.constBegin(); it != roles.constEnd(); ++it) {
+            if (it.value() == "LauncherUrlWithoutIcon") {
+                m_launcherRole = it.key();
+                break;
+            }
+        }
+
+        //! the activities of the launchers are provided from the tasks model and
+        //! they can change only together with its launchers list
+        int methodIndex = m_tasksModel->metaObject()->indexOfMethod("launcherActivities(QUrl)");
+
+        if (methodIndex >= 0) {
+            m_launcherActivitiesMethod = m_tasksModel->metaObject()->method(methodIndex);
+        }
+
+        if (m_tasksModel->metaObject()->indexOfSignal("launcherListChanged()") >= 0) {
+            connect(m_tasksModel, SIGNAL(launcherListChanged()), this, SLOT(launcherListChanged()));
+        }
+
+        connect(m_tasksModel, &QAbstractItemModel::rowsInserted, this, &LaunchersTracker::rowsInserted);
+        connect(m_tasksModel, &QAbstractItemModel::rowsRemoved, this, &LaunchersTracker::rowsRemoved);
+        connect(m_tasksModel, &QAbstractItemModel::rowsMoved, this, &LaunchersTracker::rowsMoved);
+        connect(m_tasksModel, &QAbstractItemModel::dataChanged, this, &LaunchersTracker::dataChanged);
+        connect(m_tasksModel, &QAbstractItemModel::modelReset, this, &LaunchersTracker::reset);
+        connect(m_tasksModel, &QAbstractItemModel::layoutChanged, this, &LaunchersTracker::reset);
+    }
+
+    reset();
+
+    emit tasksModelChanged();
+}
+
+bool LaunchersTracker::isSeparator(const QString &launcher)
+{
+    return launcher.contains("latte-separator");
+}
+
+QString LaunchersTracker::launcherAt(int row) const
+{
+    if (!m_tasksModel || m_launcherRole < 0) {
+        return QString();
+    }
+
+    return m_tasksModel->index(row, 0).data(m_launcherRole).toUrl().toString();
+}
+
+QString LaunchersTracker::currentActivity() const
+{
+    return m_currentActivity;
+}
+
+void LaunchersTracker::setCurrentActivity(const QString &activity)
+{
+    if (m_currentActivity == activity) {
+        return;
+    }
+
+    m_currentActivity = activity;
+    m_currentLaunchersDirty = true;
+
+    emit currentActivityChanged();
+}
+
+void LaunchersTracker::launcherListChanged()
+{
+    m_launcherActivities.clear();
+    m_currentLaunchersDirty = true;
+}
+
+bool LaunchersTracker::inCurrentActivity(const QString &launcher)
+{
+    if (!m_launcherActivitiesMethod.isValid()) {
+        return true;
+    }
+
+    auto activities = m_launcherActivities.constFind(launcher);
+
+    if (activities == m_launcherActivities.constEnd()) {
+        QStringList result;
+        m_launcherActivitiesMethod.invoke(m_tasksModel, Q_RETURN_ARG(QStringList, result), Q_ARG(QUrl, QUrl(launcher)));
+
+        activities = m_launcherActivities.insert(launcher, result);
+    }
+
+    return activities->contains(QLatin1String(NULLUUID)) || activities->contains(m_currentActivity);
+}
+
+void LaunchersTracker::updateSeparatorsCount()
+{
+    int separators{0};
+
+    for (const auto &launcher : m_launchers) {
+        if (isSeparator(launcher)) {
+            separators++;
+        }
+    }
+
+    if (m_separatorsCount != separators) {
+        m_separatorsCount = separators;
+        emit separatorsCountChanged();
+    }
+}
+
+void LaunchersTracker::reset()
+{
+    int previousCount = m_launchers.count();
+
+    m_launchers.clear();
+
+    if (m_tasksModel) {
+        int rows = m_tasksModel->rowCount();
+        m_launchers.reserve(rows);
+
+        for (int i = 0; i < rows; ++i) {
+            m_launchers << launcherAt(i);
+        }
+    }
+
+    m_rowsDirty = true;
+    m_currentLaunchersDirty = true;
+    updateSeparatorsCount();
+
+    emit launchersReset();
+
+    if (previousCount != m_launchers.count()) {
+        emit countChanged();
+    }
+}
+
+void LaunchersTracker::rowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    for (int row = first; row <= last; ++row) {
+        QString launcher = launcherAt(row);
+        m_launchers.insert(row, launcher);
+
+        if (isSeparator(launcher)) {
+            m_separatorsCount++;
+            emit separatorsCountChanged();
+        }
+
+        emit launcherInserted(row, launcher);
+    }
+
+    m_rowsDirty = true;
+    m_currentLaunchersDirty = true;
+    emit countChanged();
+}
+
+void LaunchersTracker::rowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid() || first >= m_launchers.count()) {
+        return;
+    }
+
+    last = qMin(last, m_launchers.count() - 1);
+
+    for (int row = last; row >= first; --row) {
+        QString launcher = m_launchers.takeAt(row);
+
+        if (isSeparator(launcher)) {
+            m_separatorsCount--;
+            emit separatorsCountChanged();
+        }
+
+        emit launcherRemoved(row, launcher);
+    }
+
+    m_rowsDirty = true;
+    m_currentLaunchersDirty = true;
+    emit countChanged();
+}
+
+void LaunchersTracker::rowsMoved(const QModelIndex &parent, int start, int end, const QModelIndex &destination, int row)
+{
+    if (parent.isValid() || destination.isValid()) {
+        return;
+    }
+
+    //! row is the position before the move as QAbstractItemModel::beginMoveRows() defines
+    int count = end - start + 1;
+    int to = (row > start) ? row - count : row;
+
+    QVector<QString> moved = m_launchers.mid(start, count);
+    m_launchers.remove(start, count);
+
+    for (int i = 0; i < count; ++i) {
+        m_launchers.insert(to + i, moved[i]);
+        emit launcherMoved(start + i, to + i, moved[i]);
+    }
+
+    m_rowsDirty = true;
+    m_currentLaunchersDirty = true;
+}
+
+void LaunchersTracker::dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+    if (topLeft.parent().isValid() || (!roles.isEmpty() && !roles.contains(m_launcherRole))) {
+        return;
+    }
+
+    bool separatorsChanged{false};
+
+    for (int row = topLeft.row(); row <= bottomRight.row() && row < m_launchers.count(); ++row) {
+        QString launcher = launcherAt(row);
+
+        if (m_launchers[row] != launcher) {
+            separatorsChanged = separatorsChanged || isSeparator(launcher) || isSeparator(m_launchers[row]);
+            m_launchers[row] = launcher;
+            m_rowsDirty = true;
+            m_currentLaunchersDirty = true;
+            emit launcherChanged(row, launcher);
+        }
+    }
+
+    if (separatorsChanged) {
+        updateSeparatorsCount();
+    }
+}
+
+int LaunchersTracker::launcherRow(QString launcher)
+{
+    if (m_rowsDirty) {
+        m_rows.clear();
+
+        for (int i = m_launchers.count() - 1; i >= 0; --i) {
+            //! the first row of each launcher is kept
+            m_rows[m_launchers[i]] = i;
+        }
+
+        m_rowsDirty = false;
+    }
+
+    return m_rows.value(launcher, -1);
+}
+
+QStringList LaunchersTracker::currentLaunchers()
+{
+    if (m_currentLaunchersDirty) {
+        m_currentLaunchers.clear();
+
+        for (const auto &launcher : m_launchers) {
+            if (!launcher.isEmpty() && inCurrentActivity(launcher)) {
+                m_currentLaunchers << launcher;
+            }
+        }
+
+        m_currentLaunchersDirty = false;
+    }
+
+    return m_currentLaunchers;
+}
+
+bool LaunchersTracker::currentLaunchersAre(QStringList launchers)
+{
+    return currentLaunchers() == launchers;
+}
+
+bool LaunchersTracker::launchersMatch(const QString &launcher1, const QString &launcher2)
+{
+    return !launcher1.isEmpty() && !launcher2.isEmpty()
+            && (launcher1.contains(launcher2) || launcher2.contains(launcher1));
+}
+
+int LaunchersTracker::matchingLauncher(const QStringList &launchers, const QString &launcher)
+{
+    int exact = launchers.indexOf(launcher);
+
+    if (exact >= 0 || launcher.isEmpty()) {
+        return launcher.isEmpty() ? -1 : exact;
+    }
+
+    for (int i = 0; i < launchers.count(); ++i) {
+        if (launchersMatch(launchers[i], launcher)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void LaunchersTracker::restartGarbageCollector()
+{
+    m_garbageCollectorTimer.start();
+}
+
+void LaunchersTracker::addWaitingLauncher(QString launcher)
+{
+    restartGarbageCollector();
+
+    if (!waitingLauncherExists(launcher)) {
+        m_waitingLaunchers << launcher;
+    }
+}
+
+void LaunchersTracker::removeWaitingLauncher(QString launcher)
+{
+    int pos = matchingLauncher(m_waitingLaunchers, launcher);
+
+    if (pos >= 0) {
+        m_waitingLaunchers.removeAt(pos);
+        emit waitingLauncherRemoved(launcher);
+    }
+}
+
+bool LaunchersTracker::waitingLauncherExists(QString launcher) const
+{
+    return matchingLauncher(m_waitingLaunchers, launcher) >= 0;
+}
+
+int LaunchersTracker::waitingLaunchersLength() const
+{
+    return m_waitingLaunchers.count();
+}
+
+void LaunchersTracker::addToBeAddedLauncher(QString launcher)
+{
+    restartGarbageCollector();
+
+    if (!toBeAddedLauncherExists(launcher)) {
+        m_toBeAddedLaunchers << launcher;
+    }
+}
+
+void LaunchersTracker::removeToBeAddedLauncher(QString launcher)
+{
+    int pos = matchingLauncher(m_toBeAddedLaunchers, launcher);
+
+    if (pos >= 0) {
+        m_toBeAddedLaunchers.removeAt(pos);
+    }
+}
+
+bool LaunchersTracker::toBeAddedLauncherExists(QString launcher) const
+{
+    return matchingLauncher(m_toBeAddedLaunchers, launcher) >= 0;
+}
+
+void LaunchersTracker::addImmediateLauncher(QString launcher)
+{
+    restartGarbageCollector();
+    m_immediateLaunchers.insert(launcher);
+}
+
+void LaunchersTracker::removeImmediateLauncher(QString launcher)
+{
+    m_immediateLaunchers.remove(launcher);
+}
+
+bool LaunchersTracker::immediateLauncherExists(QString launcher) const
+{
+    return m_immediateLaunchers.contains(launcher);
+}
+
+void LaunchersTracker::addLauncherToBeMoved(QString launcher, int toPos)
+{
+    restartGarbageCollector();
+
+    if (!m_toBeMovedLaunchers.contains(launcher)) {
+        m_toBeMovedLaunchers[launcher] = qMax(0, toPos);
+    }
+}
+
+void LaunchersTracker::removeLauncherToBeMoved(QString launcher)
+{
+    m_toBeMovedLaunchers.remove(launcher);
+}
+
+int LaunchersTracker::posOfLauncherToBeMoved(QString launcher) const
+{
+    return m_toBeMovedLaunchers.value(launcher, -1);
+}
+
+bool LaunchersTracker::isLauncherToBeMoved(QString launcher) const
+{
+    return m_toBeMovedLaunchers.contains(launcher);
+}
+
+QVariant LaunchersTracker::getFrozenTask(QString identifier) const
+{
+    if (!m_frozenTasks.contains(identifier)) {
+        return QVariant();
+    }
+
+    QVariantMap frozenTask;
+    frozenTask["id"] = identifier;
+    frozenTask["mScale"] = m_frozenTasks[identifier];
+
+    return frozenTask;
+}
+
+void LaunchersTracker::setFrozenTask(QString identifier, qreal scale)
+{
+    restartGarbageCollector();
+    m_frozenTasks[identifier] = scale;
+}
+
+void LaunchersTracker::removeFrozenTask(QString identifier)
+{
+    m_frozenTasks.remove(identifier);
+}
+
+void LaunchersTracker::clearTransitions()
+{
+    m_waitingLaunchers.clear();
+    m_toBeAddedLaunchers.clear();
+    m_immediateLaunchers.clear();
+    m_toBeMovedLaunchers.clear();
+    m_frozenTasks.clear();
+}
+
+}
@@ -0,0 +1,173 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LAUNCHERSTRACKER_H
+#define LAUNCHERSTRACKER_H
+
+// Qt
+#include <QAbstractItemModel>
+#include <QHash>
+#include <QMetaMethod>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+#include <QVariant>
+#include <QVector>
+
+namespace Latte {
+
+/**
+ * @brief The LaunchersTracker class,
+ * mirrors the launchers order of the tasks model row by row and holds the
+ * launchers that are in transit (waiting, to be added, to be moved, frozen
+ * tasks etc.) for the tasks plasmoid. Lookups do not need to walk the
+ * tasks list and the order is updated only for the rows that changed.
+ */
+class LaunchersTracker : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QAbstractItemModel *tasksModel READ tasksModel WRITE setTasksModel NOTIFY tasksModelChanged)
+    Q_PROPERTY(QString currentActivity READ currentActivity WRITE setCurrentActivity NOTIFY currentActivityChanged)
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int separatorsCount READ separatorsCount NOTIFY separatorsCountChanged)
+
+public:
+    explicit LaunchersTracker(QObject *parent = nullptr);
+    virtual ~LaunchersTracker();
+
+    int count() const;
+    int separatorsCount() const;
+
+    QAbstractItemModel *tasksModel() const;
+    void setTasksModel(QAbstractItemModel *model);
+
+    QString currentActivity() const;
+    void setCurrentActivity(const QString &activity);
+
+    static bool isSeparator(const QString &launcher);
+
+public slots:
+    //! launchers order
+    Q_INVOKABLE int launcherRow(QString launcher);
+    //! launchers in tasks order that are shown in current activity
+    Q_INVOKABLE QStringList currentLaunchers();
+    Q_INVOKABLE bool currentLaunchersAre(QStringList launchers);
+
+    //! waiting launchers
+    Q_INVOKABLE void addWaitingLauncher(QString launcher);
+    Q_INVOKABLE void removeWaitingLauncher(QString launcher);
+    Q_INVOKABLE bool waitingLauncherExists(QString launcher) const;
+    Q_INVOKABLE int waitingLaunchersLength() const;
+
+    //! launchers to be added
+    Q_INVOKABLE void addToBeAddedLauncher(QString launcher);
+    Q_INVOKABLE void removeToBeAddedLauncher(QString launcher);
+    Q_INVOKABLE bool toBeAddedLauncherExists(QString launcher) const;
+
+    //! immediate launchers
+    Q_INVOKABLE void addImmediateLauncher(QString launcher);
+    Q_INVOKABLE void removeImmediateLauncher(QString launcher);
+    Q_INVOKABLE bool immediateLauncherExists(QString launcher) const;
+
+    //! launchers to be moved
+    Q_INVOKABLE void addLauncherToBeMoved(QString launcher, int toPos);
+    Q_INVOKABLE void removeLauncherToBeMoved(QString launcher);
+    Q_INVOKABLE int posOfLauncherToBeMoved(QString launcher) const;
+    Q_INVOKABLE bool isLauncherToBeMoved(QString launcher) const;
+
+    //! frozen tasks, returns {id, mScale} or undefined
+    Q_INVOKABLE QVariant getFrozenTask(QString identifier) const;
+    Q_INVOKABLE void setFrozenTask(QString identifier, qreal scale);
+    Q_INVOKABLE void removeFrozenTask(QString identifier);
+
+    //! forgets all launchers in transit
+    Q_INVOKABLE void clearTransitions();
+
+signals:
+    void countChanged();
+    void separatorsCountChanged();
+    void currentActivityChanged();
+    void tasksModelChanged();
+
+    void launcherInserted(int row, QString launcher);
+    void launcherRemoved(int row, QString launcher);
+    void launcherMoved(int from, int to, QString launcher);
+    void launcherChanged(int row, QString launcher);
+    void launchersReset();
+
+    void waitingLauncherRemoved(QString launcher);
+
+private slots:
+    void rowsInserted(const QModelIndex &parent, int first, int last);
+    void rowsRemoved(const QModelIndex &parent, int first, int last);
+    void rowsMoved(const QModelIndex &parent, int start, int end, const QModelIndex &destination, int row);
+    void dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+    void reset();
+    void launcherListChanged();
+
+private:
+    QString launcherAt(int row) const;
+    bool inCurrentActivity(const QString &launcher);
+
+    void updateSeparatorsCount();
+    void restartGarbageCollector();
+
+    //! launcher urls from libtaskmanager may differ only in their query part
+    static bool launchersMatch(const QString &launcher1, const QString &launcher2);
+    static int matchingLauncher(const QStringList &launchers, const QString &launcher);
+
+private:
+    int m_launcherRole{-1};
+    int m_separatorsCount{0};
+
+    //! the row of each launcher is rebuilt only when it is requested after changes
+    bool m_rowsDirty{true};
+    //! the current activity launchers are rebuilt only when requested after changes
+    bool m_currentLaunchersDirty{true};
+
+    QString m_currentActivity;
+
+    QPointer<QAbstractItemModel> m_tasksModel;
+    QMetaMethod m_launcherActivitiesMethod;
+
+    QVector<QString> m_launchers;
+    QHash<QString, int> m_rows;
+
+    //! activities of each launcher, they are requested from the tasks model
+    //! once per launcher and are dropped when the launchers list changes
+    QHash<QString, QStringList> m_launcherActivities;
+    QStringList m_currentLaunchers;
+
+    QStringList m_waitingLaunchers;
+    QStringList m_toBeAddedLaunchers;
+    QSet<QString> m_immediateLaunchers;
+    QHash<QString, int> m_toBeMovedLaunchers;
+    QHash<QString, qreal> m_frozenTasks;
+
+    //! launchers in transit are usually used for a few secs only, records
+    //! that were not used are cleared after an interval from last addition
+    QTimer m_garbageCollectorTimer;
+};
+
+}
+
+#endif // LAUNCHERSTRACKER_H
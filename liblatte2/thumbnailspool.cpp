@@ -0,0 +1,317 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "thumbnailspool.h"
+
+// Qt
+#include <QDebug>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQuickWindow>
+
+namespace Latte {
+
+ThumbnailsPool::ThumbnailsPool(QObject *parent)
+    : QObject(parent)
+{
+    m_expireTimer.setInterval(30000);
+    m_expireTimer.setSingleShot(true);
+    connect(&m_expireTimer, &QTimer::timeout, this, &ThumbnailsPool::expireUnused);
+}
+
+ThumbnailsPool::~ThumbnailsPool()
+{
+    clear();
+
+    for (auto *thumbnail : m_inUse.keys()) {
+        disconnect(m_inUse[thumbnail]);
+    }
+}
+
+int ThumbnailsPool::capacity() const
+{
+    return m_capacity;
+}
+
+void ThumbnailsPool::setCapacity(int capacity)
+{
+    if (m_capacity == capacity || capacity < 0) {
+        return;
+    }
+
+    m_capacity = capacity;
+    trim(m_capacity);
+
+    emit capacityChanged();
+}
+
+int ThumbnailsPool::expireInterval() const
+{
+    return m_expireTimer.interval();
+}
+
+void ThumbnailsPool::setExpireInterval(int interval)
+{
+    if (m_expireTimer.interval() == interval || interval < 0) {
+        return;
+    }
+
+    m_expireTimer.setInterval(interval);
+    emit expireIntervalChanged();
+}
+
+QQuickItem *ThumbnailsPool::holder(QQuickItem *context) const
+{
+    if (!context) {
+        return nullptr;
+    }
+
+    return context->window() ? context->window()->contentItem() : context;
+}
+
+QQuickItem *ThumbnailsPool::createThumbnail(uint winId, QQuickItem *context)
+{
+    QQmlEngine *engine = qmlEngine(context);
+
+    if (!engine) {
+        return nullptr;
+    }
+
+    if (!m_component || m_component->engine() != engine) {
+        if (m_component) {
+            m_component->deleteLater();
+        }
+
+        m_component = new QQmlComponent(engine, this);
+        m_component->setData("import org.kde.plasma.core 2.0 as PlasmaCore\nPlasmaCore.WindowThumbnail {}", QUrl());
+    }
+
+    if (!m_component->isReady()) {
+        qDebug() << "thumbnails pool :: thumbnail component error :" << m_component->errorString();
+        return nullptr;
+    }
+
+    //! pooled thumbnails outlive the delegate that requested them, so they are
+    //! created in the engine root context instead of the delegate context
+    QQuickItem *thumbnail = qobject_cast<QQuickItem *>(m_component->create(engine->rootContext()));
+
+    if (!thumbnail) {
+        return nullptr;
+    }
+
+    thumbnail->setProperty("winId", winId);
+
+    connect(thumbnail, &QObject::destroyed, this, [this, thumbnail]() {
+        if (m_inUse.contains(thumbnail)) {
+            disconnect(m_inUse.take(thumbnail));
+        }
+    });
+
+    return thumbnail;
+}
+
+QQuickItem *ThumbnailsPool::acquire(QVariant winId, QQuickItem *slot)
+{
+    uint wid = winId.toUInt();
+
+    if (wid == 0 || !slot) {
+        return nullptr;
+    }
+
+    QQuickItem *thumbnail{nullptr};
+
+    //! thumbnails deleted together with their parking window are purged first
+    for (int i = m_unused.count() - 1; i >= 0; --i) {
+        if (!m_unused[i].item) {
+            m_unused.removeAt(i);
+        }
+    }
+
+    for (int i = 0; i < m_unused.count(); ++i) {
+        if (m_unused[i].winId == wid) {
+            thumbnail = m_unused.takeAt(i).item;
+            break;
+        }
+    }
+
+    if (!thumbnail) {
+        thumbnail = createThumbnail(wid, slot);
+
+        if (!thumbnail) {
+            return nullptr;
+        }
+    }
+
+    //! the thumbnail is owned by the previews window and not by the slot,
+    //! this way it survives when the slot is destroyed
+    thumbnail->setParent(holder(slot));
+    thumbnail->setParentItem(slot);
+    thumbnail->setOpacity(1);
+
+    QPointer<QQuickItem> thumbnailPtr(thumbnail);
+
+    m_inUse[thumbnail] = connect(slot, &QObject::destroyed, this, [this, thumbnailPtr]() {
+        if (thumbnailPtr) {
+            release(thumbnailPtr);
+        }
+    });
+
+    return thumbnail;
+}
+
+void ThumbnailsPool::release(QQuickItem *thumbnail)
+{
+    if (!thumbnail || !m_inUse.contains(thumbnail)) {
+        return;
+    }
+
+    disconnect(m_inUse.take(thumbnail));
+
+    QQuickItem *parking = holder(thumbnail->parentItem());
+
+    if (!parking || parking == thumbnail->parentItem()) {
+        //! the thumbnail is not inside a window any more
+        parking = qobject_cast<QQuickItem *>(thumbnail->parent());
+    }
+
+    if (!parking || m_capacity == 0) {
+        thumbnail->deleteLater();
+        return;
+    }
+
+    //! the slot anchors set from qml must not follow the parked thumbnail
+    if (QObject *anchors = qvariant_cast<QObject *>(thumbnail->property("anchors"))) {
+        anchors->setProperty("fill", QVariant::fromValue<QQuickItem *>(nullptr));
+    }
+
+    //! parked thumbnails stay visible with zero opacity, hidden thumbnails
+    //! stop redirecting their window and the compositor binding is lost
+    thumbnail->setOpacity(0);
+    thumbnail->setParentItem(parking);
+    thumbnail->setPosition(QPointF(0, 0));
+
+    Thumbnail unused;
+    unused.winId = thumbnail->property("winId").toUInt();
+    unused.item = thumbnail;
+    unused.lastUsed.start();
+
+    m_unused.prepend(unused);
+    trim(m_capacity);
+
+    if (!m_expireTimer.isActive()) {
+        m_expireTimer.start();
+    }
+}
+
+void ThumbnailsPool::prewarm(QVariantList winIds, QQuickItem *context)
+{
+    QQuickItem *parking = holder(context);
+
+    if (!parking || m_capacity == 0) {
+        return;
+    }
+
+    for (const auto &winId : winIds) {
+        uint wid = winId.toUInt();
+
+        if (wid == 0) {
+            continue;
+        }
+
+        bool exists{false};
+
+        for (const auto &unused : m_unused) {
+            if (unused.winId == wid && unused.item) {
+                exists = true;
+                break;
+            }
+        }
+
+        for (auto *thumbnail : m_inUse.keys()) {
+            if (thumbnail->property("winId").toUInt() == wid) {
+                exists = true;
+                break;
+            }
+        }
+
+        if (exists) {
+            continue;
+        }
+
+        QQuickItem *thumbnail = createThumbnail(wid, context);
+
+        if (!thumbnail) {
+            return;
+        }
+
+        thumbnail->setOpacity(0);
+        thumbnail->setParent(parking);
+        thumbnail->setParentItem(parking);
+
+        Thumbnail unused;
+        unused.winId = wid;
+        unused.item = thumbnail;
+        unused.lastUsed.start();
+
+        //! prewarmed thumbnails are less important than the ones already shown
+        m_unused.append(unused);
+    }
+
+    trim(m_capacity);
+
+    if (!m_unused.isEmpty() && !m_expireTimer.isActive()) {
+        m_expireTimer.start();
+    }
+}
+
+void ThumbnailsPool::trim(int size)
+{
+    while (m_unused.count() > size) {
+        Thumbnail unused = m_unused.takeLast();
+
+        if (unused.item) {
+            unused.item->deleteLater();
+        }
+    }
+}
+
+void ThumbnailsPool::clear()
+{
+    trim(0);
+    m_expireTimer.stop();
+}
+
+void ThumbnailsPool::expireUnused()
+{
+    for (int i = m_unused.count() - 1; i >= 0; --i) {
+        if (!m_unused[i].item || m_unused[i].lastUsed.hasExpired(m_expireTimer.interval())) {
+            Thumbnail unused = m_unused.takeAt(i);
+
+            if (unused.item) {
+                unused.item->deleteLater();
+            }
+        }
+    }
+
+    if (!m_unused.isEmpty()) {
+        m_expireTimer.start();
+    }
+}
+
+}
@@ -0,0 +1,119 @@
+/*
+*  Copyright 2019  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef THUMBNAILSPOOL_H
+#define THUMBNAILSPOOL_H
+
+// Qt
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QJSEngine>
+#include <QTimer>
+#include <QVariant>
+
+class QQmlComponent;
+
+namespace Latte {
+
+/**
+ * @brief The ThumbnailsPool class,
+ * keeps window thumbnails alive between previews. Thumbnails that are
+ * not shown any more stay hidden in the previews window for a while,
+ * so sweeping across tasks reuses the existing compositor bindings
+ * instead of creating and destroying them for every hovered task.
+ * Unused thumbnails are bounded by capacity and expire after
+ * expireInterval in order to not keep window pixmaps for ever.
+ */
+class ThumbnailsPool final : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+    Q_PROPERTY(int expireInterval READ expireInterval WRITE setExpireInterval NOTIFY expireIntervalChanged)
+
+public:
+    explicit ThumbnailsPool(QObject *parent = nullptr);
+    virtual ~ThumbnailsPool();
+
+    int capacity() const;
+    void setCapacity(int capacity);
+
+    int expireInterval() const;
+    void setExpireInterval(int interval);
+
+public slots:
+    //! returns a thumbnail for winId that is shown inside slot, the caller
+    //! is responsible to position it and to release it afterwards
+    Q_INVOKABLE QQuickItem *acquire(QVariant winId, QQuickItem *slot);
+    //! the thumbnail is kept hidden in the pool for later use
+    Q_INVOKABLE void release(QQuickItem *thumbnail);
+    //! creates hidden thumbnails for windows that are probably going to be
+    //! previewed soon, e.g. the windows of the hovered task neighbours
+    Q_INVOKABLE void prewarm(QVariantList winIds, QQuickItem *context);
+    //! deletes all the unused thumbnails
+    Q_INVOKABLE void clear();
+
+signals:
+    void capacityChanged();
+    void expireIntervalChanged();
+
+private slots:
+    void expireUnused();
+
+private:
+    struct Thumbnail {
+        uint winId{0};
+        QPointer<QQuickItem> item;
+        QElapsedTimer lastUsed;
+    };
+
+    QQuickItem *createThumbnail(uint winId, QQuickItem *context);
+    //! unused thumbnails are stored under the previews window root item
+    QQuickItem *holder(QQuickItem *context) const;
+    void trim(int size);
+
+private:
+    int m_capacity{8};
+
+    QTimer m_expireTimer;
+
+    QPointer<QQmlComponent> m_component;
+
+    //! most recently used first
+    QList<Thumbnail> m_unused;
+    //! acquired thumbnail -> its slot destruction connection
+    QHash<QQuickItem *, QMetaObject::Connection> m_inUse;
+};
+
+static QObject *thumbnailspool_qobject_singletontype_provider(QQmlEngine *engine, QJSEngine *scriptEngine)
+{
+    Q_UNUSED(engine)
+    Q_UNUSED(scriptEngine)
+
+// NOTE: QML engine is the owner of this resource
+    return new ThumbnailsPool;
+}
+
+}
+
+#endif // THUMBNAILSPOOL_H
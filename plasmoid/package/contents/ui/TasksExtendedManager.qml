@@ -38,206 +38,84 @@ import org.kde.latte 0.2 as Latte
 Item {
     id: tasksExtManager
 
-    /// Launchers that are playing an ADD or REMOVAL animation
-    /// and their Starups/Windows should be aware of
-    property variant waitingLaunchers: []
-
-    //! Launchers that must be shown IMMEDIATELY after a window removal
-    //! because they are already present from a present libtaskmanager state
-    property variant immediateLaunchers: []
-
-    //! New launchers in order to be moved in correct place:
-    //! launcher, pos)
-    property variant launchersToBeMoved: []
-
-    //! Launchers that are added from user actions. They can be used in order
-    //! to be provide adding animations
-    property variant launchersToBeAdded: []
+    signal waitingLauncherRemoved(string launch);
 
-    //! Tasks that change state (launcher,startup,window) and
-    //! at the next state must look the same concerning the parabolic effect:
-    //! (id, mScale)
-    property variant frozenTasks: []
+    //! launchers order and launchers in transit are tracked from c++
+    //! in order to avoid walking and rebuilding js arrays on every change
+    readonly property QtObject launchers: launchersTracker
 
+    Latte.LaunchersTracker {
+        id: launchersTracker
+        tasksModel: tasksModel
+        currentActivity: activityInfo.currentActivity
 
-    signal waitingLauncherRemoved(string launch);
-
+        onWaitingLauncherRemoved: tasksExtManager.waitingLauncherRemoved(launcher);
+    }
 
     /////////// FUNCTIONALITY ////////////////////
 
 
     /// WAITING LAUNCHERS
     function addWaitingLauncher(launch){
-        arraysGarbageCollectorTimer.restart();
-
-        if (waitingLauncherExists(launch)) {
-            return;
-        }
-
-        waitingLaunchers.push(launch);
+        launchersTracker.addWaitingLauncher(launch);
     }
 
     function removeWaitingLauncher(launch){
-        for(var i=0; i<waitingLaunchers.length; ++i){
-            if (equals(waitingLaunchers[i], launch)) {
-                waitingLaunchers.splice(i,1);
-                waitingLauncherRemoved(launch);
-                return;
-            }
-        }
+        launchersTracker.removeWaitingLauncher(launch);
     }
 
     function waitingLauncherExists(launch){
-        for(var i=0; i<waitingLaunchers.length; ++i){
-            if (equals(waitingLaunchers[i], launch)) {
-                return true;
-            }
-        }
-
-        return false;
-    }
-
-    function equals(waitingLauncher, launcher) {
-        var equals = ( launcher !== ""
-                      && waitingLauncher !== ""
-                      && (launcher.indexOf(waitingLauncher) >= 0 || waitingLauncher.indexOf(launcher) >= 0));
-
-        return equals;
+        return launchersTracker.waitingLauncherExists(launch);
     }
 
     function waitingLaunchersLength() {
-        return waitingLaunchers.length;
-    }
-
-    function printWaitingLaunchers() {
-        console.log("WAITING LAUNCHERS ::: " + waitingLaunchers);
+        return launchersTracker.waitingLaunchersLength();
     }
 
     //! LAUNCHERSTOBEADDED
     function addToBeAddedLauncher(launcher){
-        arraysGarbageCollectorTimer.restart();
-
-        if (toBeAddedLauncherExists(launcher)) {
-            return;
-        }
-
-        launchersToBeAdded.push(launcher);
+        launchersTracker.addToBeAddedLauncher(launcher);
     }
 
     function removeToBeAddedLauncher(launcher){
-        for(var i=0; i<launchersToBeAdded.length; ++i){
-            if (equals(launchersToBeAdded[i], launcher)) {
-                launchersToBeAdded.splice(i,1);
-                return;
-            }
-        }
+        launchersTracker.removeToBeAddedLauncher(launcher);
     }
 
     function toBeAddedLauncherExists(launcher) {
-        for(var i=0; i<launchersToBeAdded.length; ++i){
-            if (equals(launchersToBeAdded[i], launcher)) {
-                return true;
-            }
-        }
-
-        return false;
-    }
-
-
-    function printToBeAddedLaunchers() {
-        console.log("TO BE ADDED LAUNCHERS ::: " + launchersToBeAdded);
+        return launchersTracker.toBeAddedLauncherExists(launcher);
     }
 
     //! IMMEDIATELAUNCHERS
     function addImmediateLauncher(launch){
-        arraysGarbageCollectorTimer.restart();
-
-        if (!immediateLauncherExists(launch)) {
-            //console.log("Immediate Launcher Added::: "+launch);
-            immediateLaunchers.push(launch);
-        }
+        launchersTracker.addImmediateLauncher(launch);
     }
 
     function removeImmediateLauncher(launch){
-        for(var i=0; i<immediateLaunchers.length; ++i){
-            if (immediateLaunchers[i]===launch) {
-                immediateLaunchers.splice(i,1);
-                //console.log("Immediate Launcher Removed::: "+launch);
-                return;
-            }
-        }
+        launchersTracker.removeImmediateLauncher(launch);
     }
 
     function immediateLauncherExists(launch){
-        for(var i=0; i<immediateLaunchers.length; ++i){
-            if (immediateLaunchers[i]===launch) {
-                return true;
-            }
-        }
-
-        return false;
+        return launchersTracker.immediateLauncherExists(launch);
     }
 
-    function printImmediateLaunchers() {
-        console.log("IMMEDIATE LAUNCHERS ::: " + immediateLaunchers);
-    }
-    //!
-
     //! FROZENTASKS
     function getFrozenTask(identifier) {
-        for(var i=0; i<frozenTasks.length; ++i) {
-            if (frozenTasks[i].id === identifier) {
-                return frozenTasks[i];
-            }
-        }
+        return launchersTracker.getFrozenTask(identifier);
     }
 
     function removeFrozenTask(identifier) {
-        var taskIndex = -1;
-        for(var i=0; i<frozenTasks.length; ++i) {
-            if (frozenTasks[i].id === identifier) {
-                taskIndex = i;
-            }
-        }
-
-        if (taskIndex > -1) {
-            frozenTasks.splice(taskIndex, 1);
-        }
+        launchersTracker.removeFrozenTask(identifier);
     }
 
     function setFrozenTask(identifier, scale) {
-        arraysGarbageCollectorTimer.restart();
-
-        var frozenTaskExists = false;
-        console.log("SET FROZEN :: "+identifier+" - "+scale);
-        var frozenTask = getFrozenTask(identifier);
-
-        if (frozenTask) {
-            frozenTask.mScale = scale;
-        } else {
-            frozenTasks.push({id: identifier, mScale: scale});
-        }
-    }
-
-    function printFrozenTasks() {
-        var fzTasks= "";
-
-        for(var i=0; i<frozenTasks.length; ++i) {
-            fzTasks = frozenTasks[i].id + "," + frozenTasks[i].mScale + "__";
-        }
-
-        console.log("FROZEN TASKS ::: " + fzTasks);
+        launchersTracker.setFrozenTask(identifier, scale);
     }
 
     //! LAUNCHERSTOBEMOVED
 
     //! launchersToBeMoved, new launchers to have been added and must be repositioned
     function addLauncherToBeMoved(launcherUrl, toPos) {
-        arraysGarbageCollectorTimer.restart();
-
-        if (!isLauncherToBeMoved(launcherUrl)) {
-            launchersToBeMoved.push({launcher: launcherUrl, pos: Math.max(0,toPos)});
-        }
+        launchersTracker.addLauncherToBeMoved(launcherUrl, toPos);
     }
 
     function moveLauncherToCorrectPos(launcherUrl, from) {
@@ -252,55 +130,15 @@ Item {
     }
 
     function removeLauncherToBeMoved(launcherUrl) {
-        if (isLauncherToBeMoved(launcherUrl)) {
-            var sLength = launchersToBeMoved.length;
-            var index = -1;
-
-            for (var i=0; i<sLength; ++i) {
-                //!safety checker
-                if (i>=launchersToBeMoved.length)
-                    return -1;
-
-                if (launchersToBeMoved[i].launcher === launcherUrl) {
-                    index = i;
-                    break;
-                }
-            }
-
-            if (index > -1) {
-                // console.log("removing launcher to be moved:: "+launcherUrl);
-                launchersToBeMoved.splice(index, 1);
-            }
-        }
+        launchersTracker.removeLauncherToBeMoved(launcherUrl);
     }
 
     function posOfLauncherToBeMoved(launcherUrl) {
-        var sLength = launchersToBeMoved.length;
-
-        for (var i=0; i<sLength; ++i) {
-            //!safety checker
-            if (i>=launchersToBeMoved.length)
-                return -1;
-
-            if (launchersToBeMoved[i].launcher === launcherUrl)
-                return launchersToBeMoved[i].pos;
-        }
-
-        return -1;
+        return launchersTracker.posOfLauncherToBeMoved(launcherUrl);
     }
 
     function isLauncherToBeMoved(launcher) {
-        return (posOfLauncherToBeMoved(launcher) >= 0);
-    }
-
-    function printToBeMovedLaunchers() {
-        var tbmLaunchers= "";
-
-        for(var i=0; i<launchersToBeMoved.length; ++i) {
-            tbmLaunchers = launchersToBeMoved[i].launcher + "," + launchersToBeMoved[i].pos + "__";
-        }
-
-        console.log("TO BE MOVED LAUNCHERS ::: " + tbmLaunchers);
+        return launchersTracker.isLauncherToBeMoved(launcher);
     }
 
     //!Trying to avoid a binding loop in TaskItem for modelLauncherUrl
@@ -326,28 +164,4 @@ Item {
         interval: 450
         onTriggered: tasksModel.syncLaunchers();
     }
-
-
-    //! Timer to clean up all arrays used from TasksExtendedManager after a specified interval
-    //! The arrays may have ghost records that were not used from animations or other plasmoid parts.
-    //! Each record of the arrays is usually only a matter of secs to be used, cleaning them after
-    //! a big interval from the last addition it is safe
-    Timer {
-        id: arraysGarbageCollectorTimer
-        interval: 30 * 1000
-        onTriggered: {
-            console.log(" TASKS EXTENDED MANAGER Garbage Collector...");
-            tasksExtManager.printImmediateLaunchers();
-            tasksExtManager.printToBeAddedLaunchers();
-            tasksExtManager.printToBeMovedLaunchers();
-            tasksExtManager.printWaitingLaunchers();
-            tasksExtManager.printFrozenTasks();
-
-            immediateLaunchers.splice(0, immediateLaunchers.length);
-            launchersToBeAdded.splice(0, launchersToBeAdded.length);
-            launchersToBeMoved.splice(0, launchersToBeMoved.length);
-            waitingLaunchers.splice(0, waitingLaunchers.length);
-            frozenTasks.splice(0, frozenTasks.length);
-        }
-    }
 }
@@ -318,8 +318,12 @@ Item {
         } else {
             plasmoid.configuration.isInLatteDock = false;
         }
+
+        updateLaunchersSubscription();
     }
 
+    onViewLayoutNameChanged: updateLaunchersSubscription();
+
 
     Connections {
         target: plasmoid
@@ -347,6 +351,8 @@ Item {
         }
 
         onLaunchersGroupChanged:{
+            root.updateLaunchersSubscription();
+
             if( latteView && latteView.editMode) {
                 tasksModel.updateLaunchersList();
             }
@@ -500,18 +506,7 @@ Item {
     }
 
     function currentListViewLauncherList() {
-        var launch = [];
-
-        var tasks = icList.contentItem.children;
-        for(var i=0; i<tasks.length; ++i){
-            var task = icList.childAtIndex(i);
-
-            if (task!==undefined && task.launcherUrl!=="" && tasksModel.launcherInCurrentActivity(task.launcherUrl)) {
-                launch.push(task.launcherUrl);
-            }
-        }
-
-        return launch;
+        return tasksExtendedManager.launchers.currentLaunchers();
     }
 
     function hidePreview(){
@@ -1295,17 +1290,7 @@ Item {
                     }
 
                     function launcherModelIndex(url) {
-                        var tasks = icList.contentItem.children;
-
-                        for(var i=0; i<tasks.length; ++i){
-                            var task = tasks[i];
-
-                            if (task && (task.launcherUrl===url)) {
-                                return task.itemIndex;
-                            }
-                        }
-
-                        return -1;
+                        return tasksExtendedManager.launchers.launcherRow(url);
                     }
                 }
             } // ScrollPositioner
@@ -1399,7 +1384,7 @@ Item {
         property var launchers: []
 
         function launchersAreInSync() {
-            return arraysAreEqual(currentListViewLauncherList(), launchers);
+            return tasksExtendedManager.launchers.currentLaunchersAre(launchers);
         }
 
         function launcherValidPos(url) {
@@ -1762,6 +1747,24 @@ Item {
     }
 
     //! BEGIN ::: external launchers signals in order to update the tasks model
+    property QtObject subscribedLaunchersSignals: null
+
+    //! the launchers signals are informing only the plasmoids that have
+    //! subscribed for the same layout and launchers group
+    function updateLaunchersSubscription() {
+        var launchersSignals = latteView && latteView.layoutsManager ? latteView.layoutsManager.launchersSignals : null;
+
+        if (subscribedLaunchersSignals && subscribedLaunchersSignals !== launchersSignals) {
+            subscribedLaunchersSignals.unsubscribe(plasmoid.id);
+        }
+
+        subscribedLaunchersSignals = launchersSignals;
+
+        if (launchersSignals) {
+            launchersSignals.subscribe(plasmoid.id, root.viewLayoutName, latteView.launchersGroup, root);
+        }
+    }
+
     function extSignalAddLauncher(group, launcher) {
         if (group === latteView.launchersGroup) {
             tasksModel.requestAddLauncher(launcher);
@@ -2030,6 +2033,10 @@ Item {
     }
 
     Component.onDestruction: {
+        if (subscribedLaunchersSignals) {
+            subscribedLaunchersSignals.unsubscribe(plasmoid.id);
+        }
+
         root.presentWindows.disconnect(backend.presentWindows);
         root.windowsHovered.disconnect(backend.windowsHovered);
         dragHelper.dropped.disconnect(resetDragSource);
@@ -202,14 +202,43 @@ Column {
             property int winId: isWin && windows[flatIndex] !== undefined ? windows[flatIndex] : 0
 
 
-            Loader{
+            //! thumbnails are provided from a pool in order to reuse them
+            //! when sweeping across tasks instead of recreating them
+            Item{
                 id:previewThumbX11Loader
                 anchors.fill: parent
-                active: !Latte.WindowSystem.isPlatformWayland
                 visible: !albumArtImage.visible && !thumbnailSourceItem.isMinimized
 
-                sourceComponent: PlasmaCore.WindowThumbnail {
-                    winId: thumbnailSourceItem.winId
+                readonly property bool active: !Latte.WindowSystem.isPlatformWayland
+                readonly property int winId: active ? thumbnailSourceItem.winId : 0
+                property Item thumbnail: null
+
+                onWinIdChanged: updateThumbnail();
+
+                Component.onCompleted: updateThumbnail();
+                Component.onDestruction: releaseThumbnail();
+
+                function releaseThumbnail() {
+                    if (thumbnail) {
+                        Latte.ThumbnailsPool.release(thumbnail);
+                        thumbnail = null;
+                    }
+                }
+
+                function updateThumbnail() {
+                    if (thumbnail && thumbnail.winId === winId) {
+                        return;
+                    }
+
+                    releaseThumbnail();
+
+                    if (winId > 0) {
+                        thumbnail = Latte.ThumbnailsPool.acquire(winId, previewThumbX11Loader);
+
+                        if (thumbnail) {
+                            thumbnail.anchors.fill = previewThumbX11Loader;
+                        }
+                    }
                 }
             }
 
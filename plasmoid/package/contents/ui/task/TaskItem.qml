@@ -26,6 +26,7 @@ import org.kde.plasma.core 2.0 as PlasmaCore
 import org.kde.plasma.components 2.0 as PlasmaComponents
 import org.kde.plasma.plasmoid 2.0
 
+import org.kde.taskmanager 0.1 as TaskManager
 import org.kde.plasma.private.taskmanager 0.1 as TaskManagerApplet
 
 import org.kde.latte 0.2 as Latte
@@ -1058,10 +1059,41 @@ MouseArea{
 
                 taskItem.preparePreviewWindow(false);
                 windowsPreviewDlg.show(taskItem);
+                prewarmNeighbourPreviews();
             }
         }
     }
 
+    //! the thumbnails of the neighbour tasks are prepared in advance
+    //! because they are probably the next ones to be previewed
+    function prewarmNeighbourPreviews() {
+        if (Latte.WindowSystem.isPlatformWayland) {
+            return;
+        }
+
+        var winIds = [];
+        var neighbours = [itemIndex - 1, itemIndex + 1];
+        var winIdRole = root.plasma515 ? TaskManager.AbstractTasksModel.WinIdList : TaskManager.AbstractTasksModel.LegacyWinIdList;
+
+        for (var i=0; i<neighbours.length; ++i) {
+            if (neighbours[i] < 0 || neighbours[i] >= tasksModel.count) {
+                continue;
+            }
+
+            var neighbourWinIds = tasksModel.data(tasksModel.makeModelIndex(neighbours[i], -1), winIdRole);
+
+            if (neighbourWinIds) {
+                for (var j=0; j<neighbourWinIds.length; ++j) {
+                    winIds.push(neighbourWinIds[j]);
+                }
+            }
+        }
+
+        if (winIds.length > 0) {
+            Latte.ThumbnailsPool.prewarm(winIds, toolTipDelegate);
+        }
+    }
+
     function showTitleTooltip() {
         if (root.latteView && root.titleTooltips){
             var displayText = isWindow ? model.display : model.AppName;
@@ -109,15 +109,4 @@ PlasmaCore.FrameSvgItem {
         id: containmentParent
         anchors.fill: parent
     }
-
-    //! it is used in order to check the right click position
-    //! the only way to take into account the visual appearance
-    //! of the applet (including its spacers)
-    function appletContainsPos(appletId, pos) {
-        if (viewLayout) {
-            return viewLayout.appletContainsPos(appletId, pos);
-        }
-
-        return false;
-    }
 }